@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// ------------------------- Workloads -------------------------
+// One timed iteration; returns a value derived from the result (final
+// objective, ...) so the work cannot be optimised away and changes in
+// behaviour show up next to changes in speed.
+using Run = std::function<double()>;
+// Builds a workload's data (untimed) and returns its iteration
+using Setup = std::function<Run()>;
+
+struct Benchmark {
+    std::string name;
+    Setup setup;
+};
+
+class Registry {
+public:
+    void add(std::string name, Setup setup);
+    const std::vector<Benchmark>& benchmarks() const noexcept { return benchmarks_; }
+
+private:
+    std::vector<Benchmark> benchmarks_;
+};
+
+void registerGradientDescent(Registry& registry);
+void registerSimplex(Registry& registry);
+
+// Deterministic generator (splitmix64). std:: distributions differ between
+// standard libraries, which would make workloads machine dependent.
+class Rng {
+public:
+    explicit Rng(std::uint64_t seed) noexcept : state_(seed) {}
+
+    std::uint64_t next() noexcept;
+    double uniform() noexcept; // [0, 1)
+    double uniform(double lo, double hi) noexcept { return lo + (hi - lo) * uniform(); }
+
+private:
+    std::uint64_t state_;
+};
+
+// ------------------------- Running -------------------------
+struct Options {
+    double minTime = 0.2;          // seconds of measurement per benchmark
+    std::size_t repetitions = 5;   // samples; the median is reported
+    std::string filter;            // substring of the benchmark name
+};
+
+struct Result {
+    std::string name;
+    std::size_t iterations = 0;    // per sample
+    double realTime = 0.0;         // median ns per iteration
+    double minTime = 0.0;          // fastest sample, ns per iteration
+    double checksum = 0.0;
+};
+
+// Runs every benchmark matching the filter, printing one line per result
+std::vector<Result> runBenchmarks(const Registry& registry, const Options& options, std::ostream& log);
+
+// ------------------------- JSON -------------------------
+// Google Benchmark-like layout: {"context": {...}, "benchmarks": [{"name",
+// "iterations", "real_time", "min_time", "time_unit", "checksum"}, ...]}
+void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options);
+// Reads the "benchmarks" array back; throws std::runtime_error on bad input
+std::vector<Result> readJson(std::istream& in);
+
+// ------------------------- Baseline -------------------------
+// Prints a comparison table and returns the number of benchmarks whose
+// median and fastest sample are both more than `threshold` (e.g. 0.1 = 10%)
+// slower than baseline.
+// Benchmarks missing on either side are listed but do not count.
+std::size_t compareWithBaseline(const std::vector<Result>& current,
+                                const std::vector<Result>& baseline,
+                                double threshold,
+                                std::ostream& report);
+
+} // namespace bench
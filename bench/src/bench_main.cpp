@@ -0,0 +1,112 @@
+#include "bench/harness.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+void usage(const char* prog) {
+    std::cerr << "Usage: " << prog << " [--filter <substring>] [--min-time <seconds>] [--repetitions <n>]"
+              << " [--output <json>] [--baseline <json> [--threshold <fraction>] [--report-only]] [--list]\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bench::Options options;
+    std::string outputPath;
+    std::string baselinePath;
+    double threshold = 0.1;
+    bool reportOnly = false;   // compare against the baseline but never fail
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--help") || (arg == "-h")) {
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (arg == "--filter" && i + 1 < argc) {
+            options.filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            options.minTime = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--repetitions" && i + 1 < argc) {
+            options.repetitions = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--output" && i + 1 < argc) {
+            outputPath = argv[++i];
+        } else if (arg == "--baseline" && i + 1 < argc) {
+            baselinePath = argv[++i];
+        } else if (arg == "--threshold" && i + 1 < argc) {
+            threshold = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--report-only") {
+            reportOnly = true;
+        } else if (arg == "--list") {
+            list = true;
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    bench::Registry registry;
+    bench::registerGradientDescent(registry);
+    bench::registerSimplex(registry);
+    if (threshold < 0.0) {
+        std::cerr << "--threshold must be non-negative\n";
+        return EXIT_FAILURE;
+    }
+    if (list) {
+        for (const bench::Benchmark& benchmark : registry.benchmarks()) {
+            std::cout << benchmark.name << '\n';
+        }
+        return EXIT_SUCCESS;
+    }
+
+    try {
+        // Read the baseline first so a bad path fails before the long run
+        std::vector<bench::Result> baseline;
+        if (!baselinePath.empty()) {
+            std::ifstream file(baselinePath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open baseline: " + baselinePath);
+            }
+            baseline = bench::readJson(file);
+            // Entries the filter skipped are not "missing"
+            baseline.erase(std::remove_if(baseline.begin(), baseline.end(),
+                                          [&options](const bench::Result& r) {
+                                              return r.name.find(options.filter) == std::string::npos;
+                                          }),
+                           baseline.end());
+        }
+
+        // Progress goes to stderr so stdout can carry the JSON
+        const std::vector<bench::Result> results = bench::runBenchmarks(registry, options, std::cerr);
+
+        if (!outputPath.empty()) {
+            std::ofstream file(outputPath);
+            if (!file.is_open()) {
+                throw std::runtime_error("Failed to open output file: " + outputPath);
+            }
+            bench::writeJson(file, results, options);
+        } else if (baselinePath.empty()) {
+            bench::writeJson(std::cout, results, options);
+        }
+
+        if (!baselinePath.empty()) {
+            const std::size_t regressions = bench::compareWithBaseline(results, baseline, threshold, std::cout);
+            if (regressions > 0) {
+                std::cout << regressions << " benchmark(s) regressed by more than " << threshold * 100.0 << "%\n";
+                if (!reportOnly) return EXIT_FAILURE;
+            }
+        }
+    } catch (const std::exception& ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,353 @@
+#include "bench/harness.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace bench {
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+std::string formatNumber(double value) {
+    char buffer[32];
+    const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+}
+
+std::string quoted(const std::string& text) {
+    std::string out = "\"";
+    for (char ch : text) {
+        if (ch == '"' || ch == '\\') {
+            out += '\\';
+        }
+        out += ch;
+    }
+    out += '"';
+    return out;
+}
+
+// Minimal JSON reader: enough for files written by writeJson (and tools
+// that reformat them)
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    double number = 0.0;
+    std::string string;
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    const JsonValue* find(const std::string& key) const {
+        for (const auto& member : members) {
+            if (member.first == key) return &member.second;
+        }
+        return nullptr;
+    }
+};
+
+class JsonParser {
+public:
+    explicit JsonParser(std::string text) : text_(std::move(text)) {}
+
+    JsonValue parseDocument() {
+        JsonValue value = parseValue();
+        skipSpace();
+        if (pos_ != text_.size()) fail("trailing characters");
+        return value;
+    }
+
+private:
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("Invalid JSON at offset " + std::to_string(pos_) + ": " + what);
+    }
+
+    void skipSpace() {
+        while (pos_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[pos_]))) {
+            ++pos_;
+        }
+    }
+
+    bool consume(char ch) {
+        skipSpace();
+        if (pos_ < text_.size() && text_[pos_] == ch) {
+            ++pos_;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char ch) {
+        if (!consume(ch)) fail(std::string("expected '") + ch + "'");
+    }
+
+    bool consumeLiteral(const char* literal) {
+        const std::size_t length = std::char_traits<char>::length(literal);
+        if (text_.compare(pos_, length, literal) == 0) {
+            pos_ += length;
+            return true;
+        }
+        return false;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (pos_ >= text_.size()) fail("unexpected end");
+        JsonValue value;
+        const char ch = text_[pos_];
+        if (ch == '{') {
+            value.type = JsonValue::Type::Object;
+            ++pos_;
+            if (consume('}')) return value;
+            do {
+                skipSpace();
+                std::string key = parseString();
+                expect(':');
+                value.members.emplace_back(std::move(key), parseValue());
+            } while (consume(','));
+            expect('}');
+        } else if (ch == '[') {
+            value.type = JsonValue::Type::Array;
+            ++pos_;
+            if (consume(']')) return value;
+            do {
+                value.items.push_back(parseValue());
+            } while (consume(','));
+            expect(']');
+        } else if (ch == '"') {
+            value.type = JsonValue::Type::String;
+            value.string = parseString();
+        } else if (consumeLiteral("true")) {
+            value.type = JsonValue::Type::Bool;
+            value.boolean = true;
+        } else if (consumeLiteral("false")) {
+            value.type = JsonValue::Type::Bool;
+        } else if (consumeLiteral("null")) {
+            value.type = JsonValue::Type::Null;
+        } else {
+            value.type = JsonValue::Type::Number;
+            const char* begin = text_.c_str() + pos_;
+            char* end = nullptr;
+            value.number = std::strtod(begin, &end);
+            if (end == begin) fail("unexpected character");
+            pos_ += static_cast<std::size_t>(end - begin);
+        }
+        return value;
+    }
+
+    std::string parseString() {
+        if (pos_ >= text_.size() || text_[pos_] != '"') fail("expected string");
+        ++pos_;
+        std::string out;
+        while (pos_ < text_.size() && text_[pos_] != '"') {
+            char ch = text_[pos_++];
+            if (ch == '\\') {
+                if (pos_ >= text_.size()) break;
+                const char escape = text_[pos_++];
+                switch (escape) {
+                    case 'n': ch = '\n'; break;
+                    case 't': ch = '\t'; break;
+                    case 'r': ch = '\r'; break;
+                    case 'b': ch = '\b'; break;
+                    case 'f': ch = '\f'; break;
+                    case 'u':
+                        // Names are ASCII; anything else is replaced
+                        if (pos_ + 4 > text_.size()) fail("bad escape");
+                        pos_ += 4;
+                        ch = '?';
+                        break;
+                    default: ch = escape; break;
+                }
+            }
+            out += ch;
+        }
+        if (pos_ >= text_.size()) fail("unterminated string");
+        ++pos_;
+        return out;
+    }
+
+    std::string text_;
+    std::size_t pos_ = 0;
+};
+
+} // namespace
+
+// ------------------------- Workloads -------------------------
+void Registry::add(std::string name, Setup setup) {
+    benchmarks_.push_back({std::move(name), std::move(setup)});
+}
+
+std::uint64_t Rng::next() noexcept {
+    std::uint64_t z = (state_ += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+double Rng::uniform() noexcept {
+    return static_cast<double>(next() >> 11) * 0x1.0p-53;
+}
+
+// ------------------------- Running -------------------------
+std::vector<Result> runBenchmarks(const Registry& registry, const Options& options, std::ostream& log) {
+    std::vector<Result> results;
+    const std::size_t repetitions = std::max<std::size_t>(options.repetitions, 1);
+    const double perSample = std::max(options.minTime, 0.0) / static_cast<double>(repetitions);
+
+    for (const Benchmark& benchmark : registry.benchmarks()) {
+        if (!options.filter.empty() && benchmark.name.find(options.filter) == std::string::npos) {
+            continue;
+        }
+        const Run run = benchmark.setup();
+
+        // Warm-up, then size samples from one timed call
+        Result result;
+        result.name = benchmark.name;
+        result.checksum = run();
+        const auto calibrationStart = Clock::now();
+        result.checksum = run();
+        const double single = std::max(secondsSince(calibrationStart), 1e-9);
+        result.iterations = std::max<std::size_t>(1, static_cast<std::size_t>(perSample / single));
+
+        std::vector<double> samples;
+        samples.reserve(repetitions);
+        for (std::size_t r = 0; r < repetitions; ++r) {
+            const auto start = Clock::now();
+            for (std::size_t i = 0; i < result.iterations; ++i) {
+                result.checksum = run();
+            }
+            samples.push_back(secondsSince(start) * 1e9 / static_cast<double>(result.iterations));
+        }
+        std::sort(samples.begin(), samples.end());
+        result.realTime = samples[samples.size() / 2];
+        result.minTime = samples.front();
+
+        log << std::left << std::setw(36) << result.name << std::right << std::setw(14) << std::fixed
+            << std::setprecision(0) << result.realTime << " ns" << std::setw(10) << result.iterations << " iters\n"
+            << std::defaultfloat << std::flush;
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+// ------------------------- JSON -------------------------
+void writeJson(std::ostream& out, const std::vector<Result>& results, const Options& options) {
+    out << "{\n  \"context\": {\n"
+        << "    \"min_time\": " << formatNumber(options.minTime) << ",\n"
+        << "    \"repetitions\": " << options.repetitions << ",\n"
+        << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n"
+        << "  },\n  \"benchmarks\": [";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << (i == 0 ? "\n" : ",\n")
+            << "    {\"name\": " << quoted(r.name)
+            << ", \"iterations\": " << r.iterations
+            << ", \"real_time\": " << formatNumber(r.realTime)
+            << ", \"min_time\": " << formatNumber(r.minTime)
+            << ", \"time_unit\": \"ns\""
+            << ", \"checksum\": " << formatNumber(r.checksum) << "}";
+    }
+    out << "\n  ]\n}\n";
+}
+
+std::vector<Result> readJson(std::istream& in) {
+    std::string text((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    const JsonValue document = JsonParser(std::move(text)).parseDocument();
+    const JsonValue* benchmarks = document.find("benchmarks");
+    if (benchmarks == nullptr || benchmarks->type != JsonValue::Type::Array) {
+        throw std::runtime_error("JSON has no \"benchmarks\" array");
+    }
+
+    std::vector<Result> results;
+    for (const JsonValue& item : benchmarks->items) {
+        const JsonValue* name = item.find("name");
+        const JsonValue* realTime = item.find("real_time");
+        if (name == nullptr || name->type != JsonValue::Type::String || realTime == nullptr ||
+            realTime->type != JsonValue::Type::Number) {
+            throw std::runtime_error("Benchmark entry without name/real_time");
+        }
+        Result result;
+        result.name = name->string;
+        result.realTime = realTime->number;
+        if (const JsonValue* v = item.find("min_time")) result.minTime = v->number;
+        if (const JsonValue* v = item.find("iterations")) result.iterations = static_cast<std::size_t>(v->number);
+        if (const JsonValue* v = item.find("checksum")) result.checksum = v->number;
+        if (const JsonValue* unit = item.find("time_unit")) {
+            // Normalise Google Benchmark files in other units to ns
+            const double scale = unit->string == "us" ? 1e3 : unit->string == "ms" ? 1e6 : unit->string == "s" ? 1e9 : 1.0;
+            result.realTime *= scale;
+            result.minTime *= scale;
+        }
+        results.push_back(std::move(result));
+    }
+    return results;
+}
+
+// ------------------------- Baseline -------------------------
+std::size_t compareWithBaseline(const std::vector<Result>& current,
+                                const std::vector<Result>& baseline,
+                                double threshold,
+                                std::ostream& report) {
+    std::unordered_map<std::string, const Result*> byName;
+    for (const Result& result : baseline) {
+        byName[result.name] = &result;
+    }
+
+    std::size_t regressions = 0;
+    report << std::left << std::setw(36) << "benchmark" << std::right << std::setw(14) << "baseline ns"
+           << std::setw(14) << "current ns" << std::setw(10) << "change" << "  status\n";
+    for (const Result& result : current) {
+        const auto it = byName.find(result.name);
+        report << std::left << std::setw(36) << result.name << std::right << std::fixed << std::setprecision(0);
+        if (it == byName.end()) {
+            report << std::setw(14) << "-" << std::setw(14) << result.realTime << std::setw(10) << "-"
+                   << "  new\n" << std::defaultfloat;
+            continue;
+        }
+        const Result& base = *it->second;
+        const double ratio = result.realTime / base.realTime;
+        // A slow median alone is often a noisy neighbour; require the best
+        // sample to be slower too before calling it a regression
+        const bool minSlower = base.minTime <= 0.0 || result.minTime > base.minTime * (1.0 + threshold);
+        const char* status = "ok";
+        if (ratio > 1.0 + threshold && minSlower) {
+            status = "REGRESSION";
+            ++regressions;
+        } else if (ratio < 1.0 / (1.0 + threshold)) {
+            status = "improved";
+        }
+        report << std::setw(14) << base.realTime << std::setw(14) << result.realTime << std::setw(9)
+               << std::showpos << std::setprecision(1) << (ratio - 1.0) * 100.0 << std::noshowpos << "%  " << status;
+        if (result.checksum != base.checksum) {
+            report << " (result changed: " << std::defaultfloat << std::setprecision(17) << base.checksum << " -> "
+                   << result.checksum << ")";
+        }
+        report << '\n' << std::defaultfloat << std::setprecision(6);
+        byName.erase(it);
+    }
+    for (const Result& base : baseline) {
+        if (byName.count(base.name) != 0) {
+            report << std::left << std::setw(36) << base.name << std::right << "  missing from this run\n";
+        }
+    }
+    return regressions;
+}
+
+} // namespace bench
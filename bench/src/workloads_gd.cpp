@@ -0,0 +1,211 @@
+#include "bench/harness.hpp"
+
+#include "gd/autodiff.hpp"
+#include "gd/fixed.hpp"
+#include "gd/gradient_descent.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+namespace {
+
+// Runs exactly maxIterations steps: the tolerance is never met
+gd::OptimConfig fixedWork(double learningRate, std::size_t iterations) {
+    gd::OptimConfig config;
+    config.learningRate = learningRate;
+    config.tolerance = 1e-300;
+    config.maxIterations = iterations;
+    return config;
+}
+
+// 0.5 * sum d_i x_i^2 with d log-spaced in [1, 100] (condition number 100)
+class DiagonalQuadratic final : public gd::Objective {
+public:
+    explicit DiagonalQuadratic(std::size_t dimension)
+        : Objective(dimension), diagonal_(dimension) {
+        for (std::size_t i = 0; i < dimension; ++i) {
+            const double t = dimension > 1 ? static_cast<double>(i) / static_cast<double>(dimension - 1) : 0.0;
+            diagonal_[i] = std::pow(100.0, t);
+        }
+    }
+
+    double value(const gd::Vector& x) const override {
+        double sum = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            sum += diagonal_[i] * x[i] * x[i];
+        }
+        return 0.5 * sum;
+    }
+
+    bool hasAnalyticGradient() const noexcept override { return true; }
+
+    gd::Vector analyticGradient(const gd::Vector& x) const override {
+        gd::Vector grad(x.size());
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            grad[i] = diagonal_[i] * x[i];
+        }
+        return grad;
+    }
+
+private:
+    gd::Vector diagonal_;
+};
+
+// Extended Rosenbrock: sum over pairs of 100 (x2 - x1^2)^2 + (1 - x1)^2.
+// `analytic` = false exercises the finite-difference gradient.
+class ExtendedRosenbrock final : public gd::Objective {
+public:
+    ExtendedRosenbrock(std::size_t dimension, bool analytic)
+        : Objective(dimension), analytic_(analytic) {}
+
+    double value(const gd::Vector& x) const override {
+        double sum = 0.0;
+        for (std::size_t i = 0; i + 1 < x.size(); i += 2) {
+            const double a = x[i + 1] - x[i] * x[i];
+            const double b = 1.0 - x[i];
+            sum += 100.0 * a * a + b * b;
+        }
+        return sum;
+    }
+
+    bool hasAnalyticGradient() const noexcept override { return analytic_; }
+
+    gd::Vector analyticGradient(const gd::Vector& x) const override {
+        gd::Vector grad(x.size(), 0.0);
+        for (std::size_t i = 0; i + 1 < x.size(); i += 2) {
+            const double a = x[i + 1] - x[i] * x[i];
+            grad[i] = -400.0 * x[i] * a - 2.0 * (1.0 - x[i]);
+            grad[i + 1] = 200.0 * a;
+        }
+        return grad;
+    }
+
+private:
+    bool analytic_;
+};
+
+// Same function written once for double and ad::Var
+class AutodiffRosenbrock final : public gd::AutodiffObjective<AutodiffRosenbrock> {
+public:
+    using AutodiffObjective::AutodiffObjective;
+
+    template <class T>
+    T evaluate(const std::vector<T>& x) const {
+        T sum = 0.0;
+        for (std::size_t i = 0; i + 1 < x.size(); i += 2) {
+            const T a = x[i + 1] - x[i] * x[i];
+            const T b = 1.0 - x[i];
+            sum += 100.0 * a * a + b * b;
+        }
+        return sum;
+    }
+};
+
+gd::Vector rosenbrockStart(std::size_t dimension) {
+    gd::Vector x(dimension);
+    for (std::size_t i = 0; i < dimension; ++i) {
+        x[i] = (i % 2 == 0) ? -1.2 : 1.0;
+    }
+    return x;
+}
+
+template <std::size_t N>
+struct FixedRosenbrock : gd::fixed::Objective<FixedRosenbrock<N>, N> {
+    static constexpr bool hasAnalyticGradient = true;
+
+    double value(const gd::fixed::Vector<N>& x) const {
+        double sum = 0.0;
+        for (std::size_t i = 0; i + 1 < N; i += 2) {
+            const double a = x[i + 1] - x[i] * x[i];
+            const double b = 1.0 - x[i];
+            sum += 100.0 * a * a + b * b;
+        }
+        return sum;
+    }
+
+    gd::fixed::Vector<N> analyticGradient(const gd::fixed::Vector<N>& x) const {
+        gd::fixed::Vector<N> grad{};
+        for (std::size_t i = 0; i + 1 < N; i += 2) {
+            const double a = x[i + 1] - x[i] * x[i];
+            grad[i] = -400.0 * x[i] * a - 2.0 * (1.0 - x[i]);
+            grad[i + 1] = 200.0 * a;
+        }
+        return grad;
+    }
+};
+
+Setup trainerWorkload(std::shared_ptr<gd::Objective> objective, gd::Vector start, gd::OptimConfig config) {
+    return [objective, start, config] {
+        return Run([objective, start, config] {
+            const gd::Trainer trainer;
+            gd::Vector x = start;
+            gd::OptimConfig runConfig = config;
+            return trainer.minimize(*objective, x, runConfig, {}).finalValue;
+        });
+    };
+}
+
+template <std::size_t N>
+Setup fixedRosenbrockWorkload(std::size_t iterations) {
+    return [iterations] {
+        return Run([iterations] {
+            FixedRosenbrock<N> objective;
+            gd::fixed::Vector<N> x{};
+            for (std::size_t i = 0; i < N; ++i) {
+                x[i] = (i % 2 == 0) ? -1.2 : 1.0;
+            }
+            gd::OptimConfig config = fixedWork(1e-3, iterations);
+            return gd::fixed::Trainer<N>().minimize(objective, x, config).finalValue;
+        });
+    };
+}
+
+} // namespace
+
+void registerGradientDescent(Registry& registry) {
+    // Quadratic family; the largest size crosses the parallel kernel threshold
+    const std::size_t quadraticSizes[] = {16, 1024, 131072};
+    for (std::size_t n : quadraticSizes) {
+        const std::size_t iterations = n >= 131072 ? 20 : 200;
+        registry.add("gd/quadratic/" + std::to_string(n), [n, iterations] {
+            Rng rng(n);
+            gd::Vector start(n);
+            for (double& v : start) {
+                v = rng.uniform(-1.0, 1.0);
+            }
+            return trainerWorkload(std::make_shared<DiagonalQuadratic>(n), start, fixedWork(1e-2, iterations))();
+        });
+    }
+
+    const std::size_t rosenbrockSizes[] = {2, 64, 4096};
+    for (std::size_t n : rosenbrockSizes) {
+        registry.add("gd/rosenbrock/" + std::to_string(n), [n] {
+            return trainerWorkload(std::make_shared<ExtendedRosenbrock>(n, true), rosenbrockStart(n),
+                                   fixedWork(1e-3, 500))();
+        });
+    }
+
+    const std::size_t finiteDifferenceSizes[] = {2, 16};
+    for (std::size_t n : finiteDifferenceSizes) {
+        registry.add("gd/rosenbrock_fd/" + std::to_string(n), [n] {
+            return trainerWorkload(std::make_shared<ExtendedRosenbrock>(n, false), rosenbrockStart(n),
+                                   fixedWork(1e-3, 500))();
+        });
+    }
+
+    const std::size_t autodiffSizes[] = {2, 16, 1024};
+    for (std::size_t n : autodiffSizes) {
+        registry.add("gd/rosenbrock_ad/" + std::to_string(n), [n] {
+            return trainerWorkload(std::make_shared<AutodiffRosenbrock>(n), rosenbrockStart(n),
+                                   fixedWork(1e-3, 500))();
+        });
+    }
+
+    registry.add("gd_fixed/rosenbrock/2", fixedRosenbrockWorkload<2>(500));
+    registry.add("gd_fixed/rosenbrock/8", fixedRosenbrockWorkload<8>(500));
+}
+
+} // namespace bench
@@ -0,0 +1,113 @@
+#include "bench/harness.hpp"
+
+#include "simplex/interior_point.hpp"
+#include "simplex/simplex.hpp"
+
+#include <cmath>
+#include <memory>
+#include <string>
+
+namespace bench {
+namespace {
+
+// Bounded, feasible instances: A >= 0 with a positive entry in every column,
+// b > 0 (x = 0 is feasible) and c > 0. `density` is the fraction of nonzeros.
+simplex::Problem randomProblem(std::size_t m, std::size_t n, double density, std::uint64_t seed) {
+    Rng rng(seed);
+    simplex::Problem problem;
+    problem.numConstraints = m;
+    problem.numVariables = n;
+    problem.A.assign(m * n, 0.0);
+    problem.b.resize(m);
+    problem.c.resize(n);
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            if (rng.uniform() < density) {
+                problem.A[i * n + j] = rng.uniform(0.1, 1.0);
+            }
+        }
+        problem.b[i] = rng.uniform(1.0, 10.0);
+    }
+    for (std::size_t j = 0; j < n; ++j) {
+        const std::size_t row = static_cast<std::size_t>(rng.next() % m);
+        if (problem.A[row * n + j] == 0.0) {
+            problem.A[row * n + j] = rng.uniform(0.1, 1.0);
+        }
+        problem.c[j] = rng.uniform(0.5, 1.5);
+    }
+    return problem;
+}
+
+// Klee-Minty cube: Dantzig's rule visits all 2^n vertices, while the
+// interior-point iteration count grows only slowly with n
+simplex::Problem kleeMinty(std::size_t n) {
+    simplex::Problem problem;
+    problem.numConstraints = n;
+    problem.numVariables = n;
+    problem.A.assign(n * n, 0.0);
+    problem.b.resize(n);
+    problem.c.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            problem.A[i * n + j] = std::pow(2.0, static_cast<double>(i - j + 1));
+        }
+        problem.A[i * n + i] = 1.0;
+        problem.b[i] = std::pow(5.0, static_cast<double>(i + 1));
+        problem.c[i] = std::pow(2.0, static_cast<double>(n - 1 - i));
+    }
+    return problem;
+}
+
+std::string shapeName(const char* family, std::size_t m, std::size_t n) {
+    return std::string("simplex/") + family + "/" + std::to_string(m) + "x" + std::to_string(n);
+}
+
+// Reuses one Workspace across iterations, as a long-running caller would
+Setup simplexWorkload(simplex::Problem problem) {
+    return [problem] {
+        auto workspace = std::make_shared<simplex::Workspace>();
+        return Run([problem, workspace] {
+            const simplex::Solution solution = simplex::SimplexSolver().solve(problem, *workspace);
+            return solution.status == simplex::Status::Optimal ? solution.objective : -1.0;
+        });
+    };
+}
+
+Setup interiorPointWorkload(simplex::Problem problem, bool crossover) {
+    return [problem, crossover] {
+        simplex::InteriorPointOptions options;
+        options.crossover = crossover;
+        return Run([problem, options] {
+            const simplex::Solution solution = simplex::InteriorPointSolver(options).solve(problem);
+            return solution.status == simplex::Status::Optimal ? solution.objective : -1.0;
+        });
+    };
+}
+
+simplex::Problem seededProblem(std::size_t m, std::size_t n, double density) {
+    return randomProblem(m, n, density, m * 1000003u + n);
+}
+
+} // namespace
+
+void registerSimplex(Registry& registry) {
+    const std::size_t dense[][2] = {{16, 16}, {64, 64}, {128, 256}};
+    for (const auto& shape : dense) {
+        registry.add(shapeName("dense", shape[0], shape[1]), simplexWorkload(seededProblem(shape[0], shape[1], 1.0)));
+    }
+
+    const std::size_t sparse[][2] = {{128, 128}, {256, 256}};
+    for (const auto& shape : sparse) {
+        registry.add(shapeName("sparse", shape[0], shape[1]), simplexWorkload(seededProblem(shape[0], shape[1], 0.05)));
+    }
+
+    registry.add("simplex/klee_minty/14", simplexWorkload(kleeMinty(14)));
+
+    // Interior point on the same instances as the largest tableau runs
+    registry.add("ipm/dense/128x256", interiorPointWorkload(seededProblem(128, 256, 1.0), false));
+    registry.add("ipm/sparse/256x256", interiorPointWorkload(seededProblem(256, 256, 0.05), false));
+    registry.add("ipm_crossover/sparse/256x256", interiorPointWorkload(seededProblem(256, 256, 0.05), true));
+    registry.add("ipm/klee_minty/14", interiorPointWorkload(kleeMinty(14), false));
+}
+
+} // namespace bench
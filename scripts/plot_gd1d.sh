@@ -10,7 +10,7 @@ Options:
   -b, --a2 VALUE        Cubic coefficient for x^2 term (required)
   -c, --a1 VALUE        Cubic coefficient for x term (required)
   -d, --a0 VALUE        Constant term (required)
-  -i, --input FILE      Gradient descent CSV trace (required)
+  -i, --input FILE      Gradient descent CSV trace or binary trajectory (required)
   -o, --output FILE     Output image path (required)
       --format fmt      Output format: png (default) or svg
       --margin FACTOR   Margin factor beyond extrema/trajectory (default 1.5)
@@ -20,6 +20,7 @@ Options:
       --traj-color HEX  Colour for trajectory (default #d62728)
       --curve-color HEX Colour for objective curve (default #1f77b4)
       --xrange MIN:MAX  Override automatic x-range
+      --max-rows N      Rows kept when decimating a binary trajectory (default 5000)
       --title TEXT      Custom plot title
       --show            Attempt to open the output with xdg-open when finished
       --help            Show this message
@@ -49,6 +50,8 @@ curve_color="#1f77b4"
 xrange_override=""
 custom_title=""
 show_flag=0
+max_rows="5000"
+converted_csv=""
 
 a3=""
 a2=""
@@ -101,6 +104,9 @@ while [ $# -gt 0 ]; do
     --xrange)
       [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
       xrange_override="$2"; shift 2 ;;
+    --max-rows)
+      [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
+      max_rows="$2"; shift 2 ;;
     --title)
       [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
       custom_title="$2"; shift 2 ;;
@@ -126,6 +132,22 @@ if [ ! -f "$csv" ]; then
   exit 1
 fi
 
+# Binary trajectories (gd::TrajectoryLogger) are decimated into a temporary CSV
+if [ "$(head -c 6 "$csv")" = "GDTRAJ" ]; then
+  traj2csv="${TRAJ2CSV:-$(cd -- "$(dirname "$0")/.." && pwd)/build/topics/gradient_descent/traj2csv}"
+  if [ ! -x "$traj2csv" ]; then
+    echo "Error: traj2csv not found at '$traj2csv' (build it or set TRAJ2CSV)" >&2
+    exit 1
+  fi
+  converted_csv=$(mktemp /tmp/plot_gd1d.XXXXXX.csv)
+  trap 'rm -f "$converted_csv"' EXIT
+  "$traj2csv" --input "$csv" --output "$converted_csv" --max-rows "$max_rows" >/dev/null 2>&1 || {
+    echo "Error: failed to convert trajectory '$csv'" >&2
+    exit 1
+  }
+  csv="$converted_csv"
+fi
+
 if [ "$format" != "png" ] && [ "$format" != "svg" ]; then
   echo "Error: unsupported format '$format'" >&2
   exit 1
@@ -252,7 +274,7 @@ case "$format" in
 esac
 
 script_file=$(mktemp /tmp/plot_gd1d.XXXXXX.gp)
-trap 'rm -f "$script_file"' EXIT
+trap 'rm -f "$script_file" ${converted_csv:+"$converted_csv"}' EXIT
 
 cat <<GNUPLOT > "$script_file"
 $term_cmd
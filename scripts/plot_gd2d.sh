@@ -12,7 +12,7 @@ Options:
   -p, --b1 VALUE        Linear coefficient for x1 term (required)
   -q, --b2 VALUE        Linear coefficient for x2 term (required)
   -r, --c0 VALUE        Constant term (required)
-  -i, --input FILE      Gradient descent CSV trace (required)
+  -i, --input FILE      Gradient descent CSV trace or binary trajectory (required)
   -o, --output FILE     Output image path (required)
       --format fmt      Output format: png (default) or svg
       --margin FACTOR   Fractional padding around trajectory bounds (default 0.25)
@@ -23,6 +23,7 @@ Options:
       --contour-color HEX Colour for contours (default #4c72b0)
       --xrange MIN:MAX  Override x range
       --yrange MIN:MAX  Override y range
+      --max-rows N      Rows kept when decimating a binary trajectory (default 5000)
       --title TEXT      Custom title
       --show            Attempt to open the output with xdg-open when finished
       --help            Show this message
@@ -52,6 +53,8 @@ xrange_override=""
 yrange_override=""
 custom_title=""
 show_flag=0
+max_rows="5000"
+converted_csv=""
 
 a11=""
 a22=""
@@ -115,6 +118,9 @@ while [ $# -gt 0 ]; do
     --yrange)
       [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
       yrange_override="$2"; shift 2 ;;
+    --max-rows)
+      [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
+      max_rows="$2"; shift 2 ;;
     --title)
       [ $# -ge 2 ] || { echo "Error: option $1 requires an argument" >&2; exit 1; }
       custom_title="$2"; shift 2 ;;
@@ -140,6 +146,22 @@ if [ ! -f "$csv" ]; then
   exit 1
 fi
 
+# Binary trajectories (gd::TrajectoryLogger) are decimated into a temporary CSV
+if [ "$(head -c 6 "$csv")" = "GDTRAJ" ]; then
+  traj2csv="${TRAJ2CSV:-$(cd -- "$(dirname "$0")/.." && pwd)/build/topics/gradient_descent/traj2csv}"
+  if [ ! -x "$traj2csv" ]; then
+    echo "Error: traj2csv not found at '$traj2csv' (build it or set TRAJ2CSV)" >&2
+    exit 1
+  fi
+  converted_csv=$(mktemp /tmp/plot_gd2d.XXXXXX.csv)
+  trap 'rm -f "$converted_csv"' EXIT
+  "$traj2csv" --input "$csv" --output "$converted_csv" --max-rows "$max_rows" >/dev/null 2>&1 || {
+    echo "Error: failed to convert trajectory '$csv'" >&2
+    exit 1
+  }
+  csv="$converted_csv"
+fi
+
 if [ "$format" != "png" ] && [ "$format" != "svg" ]; then
   echo "Error: unsupported format '$format'" >&2
   exit 1
@@ -230,7 +252,7 @@ esac
 
 contour_file=$(mktemp /tmp/gd2d_contours.XXXXXX.dat)
 script_file=$(mktemp /tmp/plot_gd2d.XXXXXX.gp)
-trap 'rm -f "$contour_file" "$script_file"' EXIT
+trap 'rm -f "$contour_file" "$script_file" ${converted_csv:+"$converted_csv"}' EXIT
 
 cat <<GNUPLOT > "$script_file"
 $term_cmd
@@ -0,0 +1,56 @@
+#!/usr/bin/env bash
+set -euo pipefail
+
+ROOT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")/.." && pwd)"
+BUILD_DIR="${BUILD_DIR:-$ROOT_DIR/build}"
+SOCKET_PATH="${SOCKET_PATH:-${TMPDIR:-/tmp}/solverd.$$.sock}"
+REPEAT=10000
+DEPTH=16
+
+while [[ $# -gt 0 ]]; do
+    case "$1" in
+        --socket)
+            SOCKET_PATH="$2"
+            shift 2
+            ;;
+        --repeat)
+            REPEAT="$2"
+            shift 2
+            ;;
+        --depth)
+            DEPTH="$2"
+            shift 2
+            ;;
+        --help|-h)
+            echo "Usage: $0 [--socket path] [--repeat n] [--depth d]"
+            echo "Starts solverd, sends LP and GD demo jobs with solver_client, then stops it."
+            exit 0
+            ;;
+        *)
+            echo "Unknown argument: $1" >&2
+            exit 1
+            ;;
+    esac
+done
+
+cmake -S "$ROOT_DIR" -B "$BUILD_DIR" >/dev/null
+cmake --build "$BUILD_DIR" --target solverd solver_client >/dev/null
+
+SERVICE_DIR="$BUILD_DIR/topics/solver_service"
+"$SERVICE_DIR/solverd" --socket "$SOCKET_PATH" &
+SERVER_PID=$!
+trap 'kill "$SERVER_PID" 2>/dev/null || true; wait "$SERVER_PID" 2>/dev/null || true' EXIT
+
+for _ in $(seq 50); do
+    [[ -S "$SOCKET_PATH" ]] && break
+    sleep 0.1
+done
+
+echo "== LP (topics/simplex/examples/sample.lp)"
+"$SERVICE_DIR/solver_client" --socket "$SOCKET_PATH" \
+    --lp "$ROOT_DIR/topics/simplex/examples/sample.lp" --repeat "$REPEAT" --depth "$DEPTH"
+
+echo "== GD (quadratic surface)"
+"$SERVICE_DIR/solver_client" --socket "$SOCKET_PATH" \
+    --quadratic 3,2,0.5,1,-1 --start 5,5 --alpha 0.05 --eps 1e-6 --max-iters 400 \
+    --repeat "$REPEAT" --depth "$DEPTH"
@@ -1,4 +1,8 @@
+#include "gd/checkpoint.hpp"
+#include "gd/convergence.hpp"
 #include "gd/gradient_descent.hpp"
+#include "gd/proximal.hpp"
+#include "gd/trajectory.hpp"
 
 #include <cmath>
 #include <cstdlib>
@@ -6,6 +10,7 @@
 #include <exception>
 #include <iostream>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 namespace {
@@ -23,12 +28,35 @@ struct Args {
     double x1{0.0};
     double x2{0.0};
     std::string csvPath{"outputs/out2d.csv"};
+    std::size_t logEvery{1};
+    std::string trajPath;
+    bool profile{false};
+    std::string checkpointPath;
+    std::size_t checkpointEvery{100};
+    bool resume{false};
+    double ftolAbs{0.0};
+    double ftolRel{0.0};
+    std::size_t ftolWindow{10};
+    double xtol{0.0};
+    double gtol2{0.0};
+    double timeBudget{0.0};
+    std::size_t maxEvals{0};
+    std::string prox;          // "", "box", "l1", "l2-ball" or "simplex"
+    double proxParam{0.0};     // box lower bound, L1 weight or radius
+    double proxUpper{0.0};     // box upper bound
+    bool fista{false};
+    gd::TrajectoryEncoding trajEncoding{gd::TrajectoryEncoding::Float64};
 };
 
 void usage(const char *prog) {
     std::cerr << "Usage: " << prog
               << " --a11 <v> --a22 <v> --a12 <v> --b1 <v> --b2 <v> --c0 <v>"
-              << " --alpha <v> --eps <v> --max-iters <n> --x1 <v> --x2 <v> --csv <path>\n";
+              << " --alpha <v> --eps <v> --max-iters <n> --x1 <v> --x2 <v> --csv <path> [--log-every <k>]"
+              << " [--traj <path> [--traj-encoding f64|f32|delta]] [--profile]"
+              << " [--ftol-abs <v>] [--ftol-rel <v>] [--ftol-window <n>] [--xtol <v>] [--gtol2 <v>]"
+              << " [--time-budget <s>] [--max-evals <n>]"
+              << " [--checkpoint <path> [--checkpoint-every <n>] [--resume]]"
+              << " [--box <lo>:<hi> | --l1 <lambda> | --l2-ball <r> | --simplex <r>] [--fista]\n";
 }
 
 bool parseArgs(int argc, char **argv, Args &args) {
@@ -57,6 +85,59 @@ bool parseArgs(int argc, char **argv, Args &args) {
             args.x2 = std::atof(argv[++i]);
         } else if (std::strcmp(argv[i], "--csv") == 0 && i + 1 < argc) {
             args.csvPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--log-every") == 0 && i + 1 < argc) {
+            args.logEvery = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            args.checkpointPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+            args.checkpointEvery = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--resume") == 0) {
+            args.resume = true;
+        } else if (std::strcmp(argv[i], "--box") == 0 && i + 1 < argc) {
+            char *end = nullptr;
+            args.prox = "box";
+            args.proxParam = std::strtod(argv[++i], &end);
+            if (*end != ':') {
+                usage(argv[0]);
+                return false;
+            }
+            args.proxUpper = std::strtod(end + 1, nullptr);
+        } else if ((std::strcmp(argv[i], "--l1") == 0 || std::strcmp(argv[i], "--l2-ball") == 0 ||
+                    std::strcmp(argv[i], "--simplex") == 0) && i + 1 < argc) {
+            args.prox = argv[i] + 2;
+            args.proxParam = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--fista") == 0) {
+            args.fista = true;
+        } else if (std::strcmp(argv[i], "--ftol-abs") == 0 && i + 1 < argc) {
+            args.ftolAbs = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--ftol-rel") == 0 && i + 1 < argc) {
+            args.ftolRel = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--ftol-window") == 0 && i + 1 < argc) {
+            args.ftolWindow = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--xtol") == 0 && i + 1 < argc) {
+            args.xtol = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--gtol2") == 0 && i + 1 < argc) {
+            args.gtol2 = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--time-budget") == 0 && i + 1 < argc) {
+            args.timeBudget = std::strtod(argv[++i], nullptr);
+        } else if (std::strcmp(argv[i], "--max-evals") == 0 && i + 1 < argc) {
+            args.maxEvals = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            args.profile = true;
+        } else if (std::strcmp(argv[i], "--traj") == 0 && i + 1 < argc) {
+            args.trajPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--traj-encoding") == 0 && i + 1 < argc) {
+            const char *name = argv[++i];
+            if (std::strcmp(name, "f64") == 0) {
+                args.trajEncoding = gd::TrajectoryEncoding::Float64;
+            } else if (std::strcmp(name, "f32") == 0) {
+                args.trajEncoding = gd::TrajectoryEncoding::Float32;
+            } else if (std::strcmp(name, "delta") == 0) {
+                args.trajEncoding = gd::TrajectoryEncoding::DeltaFloat32;
+            } else {
+                usage(argv[0]);
+                return false;
+            }
         } else {
             usage(argv[0]);
             return false;
@@ -110,14 +191,64 @@ int main(int argc, char **argv) {
         config.tolerance = args.eps;
         config.maxIterations = args.maxIters;
 
-        gd::Trainer trainer;
-        auto csvLogger = std::make_shared<gd::CsvLogger>(args.csvPath);
-        std::vector<std::shared_ptr<gd::Callback>> callbacks{csvLogger};
+        std::shared_ptr<const gd::ProximalOperator> proximal;
+        if (args.prox == "box") {
+            proximal = std::make_shared<gd::BoxProjection>(args.proxParam, args.proxUpper);
+        } else if (args.prox == "l1") {
+            proximal = std::make_shared<gd::L1Proximal>(args.proxParam);
+        } else if (args.prox == "l2-ball") {
+            proximal = std::make_shared<gd::L2BallProjection>(args.proxParam);
+        } else if (args.prox == "simplex") {
+            proximal = std::make_shared<gd::SimplexProjection>(args.proxParam);
+        }
+        gd::Trainer trainer(proximal, args.fista);
+        std::vector<std::shared_ptr<gd::Callback>> callbacks;
+        if (!args.checkpointPath.empty()) {
+            callbacks.push_back(std::make_shared<gd::CheckpointCallback>(args.checkpointPath, args.checkpointEvery));
+        }
+        callbacks.push_back(std::make_shared<gd::CsvLogger>(args.csvPath, args.logEvery, 1 << 16, args.resume));
+        if (args.ftolAbs > 0.0 || args.ftolRel > 0.0) {
+            callbacks.push_back(std::make_shared<gd::ValueChangeStop>(args.ftolWindow, args.ftolAbs, args.ftolRel));
+        }
+        if (args.xtol > 0.0) {
+            callbacks.push_back(std::make_shared<gd::StepSizeStop>(args.xtol));
+        }
+        if (args.gtol2 > 0.0) {
+            callbacks.push_back(std::make_shared<gd::GradientNormStop>(args.gtol2));
+        }
+        if (args.timeBudget > 0.0) {
+            callbacks.push_back(std::make_shared<gd::TimeBudgetStop>(args.timeBudget));
+        }
+        if (args.maxEvals > 0) {
+            callbacks.push_back(std::make_shared<gd::EvaluationBudgetStop>(args.maxEvals));
+        }
+        if (!args.trajPath.empty()) {
+            callbacks.push_back(std::make_shared<gd::TrajectoryLogger>(args.trajPath, args.trajEncoding, args.logEvery,
+                                                                        1 << 16, args.resume));
+        }
 
-        const gd::TrainStats stats = trainer.minimize(objective, x, config, callbacks);
+        if (args.resume && args.checkpointPath.empty()) {
+            throw std::runtime_error("--resume requires --checkpoint");
+        }
+        gd::TrainStats stats;
+        if (args.resume) {
+            // --eps and --max-iters apply to the resumed run; the step size is the checkpoint's
+            const gd::Checkpoint checkpoint = gd::loadCheckpoint(args.checkpointPath);
+            if (checkpoint.config.learningRate != config.learningRate) {
+                std::cerr << "Note: resuming with the checkpoint's learning rate " << checkpoint.config.learningRate
+                          << " (--alpha " << config.learningRate << " ignored)" << std::endl;
+            }
+            stats = trainer.resume(objective, checkpoint, x, config, callbacks);
+        } else {
+            stats = trainer.minimize(objective, x, config, callbacks);
+        }
         std::cout << "Final value: " << stats.finalValue
-                  << " after " << stats.iterations << " iterations" << std::endl;
+                  << " after " << stats.iterations << " iterations ("
+                  << gd::stopReasonToString(stats.stopReason) << ")" << std::endl;
         std::cout << "Minimizer x = (" << x[0] << ", " << x[1] << ")" << std::endl;
+        if (args.profile) {
+            gd::writeProfile(std::cout, stats.profile);
+        }
 
     } catch (const std::exception &ex) {
         std::cerr << "Error: " << ex.what() << std::endl;
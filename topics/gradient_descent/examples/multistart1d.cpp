@@ -0,0 +1,162 @@
+#include "gd/multi_start.hpp"
+
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Args {
+    double a3{1.0};
+    double a2{-4.0};
+    double a1{5.0};
+    double a0{-2.0};
+    std::vector<double> alphas{0.01, 0.1};
+    std::vector<double> starts{0.5, 1.5, 2.0, 3.5, 6.0};
+    double eps{1e-2};
+    std::size_t maxIters{100};
+    std::size_t threads{0};
+    bool hasTarget{false};
+    double target{0.0};
+};
+
+void usage(const char *prog) {
+    std::cerr << "Usage: " << prog
+              << " [--a3 <v> --a2 <v> --a1 <v> --a0 <v>]"
+              << " [--alphas <v,v,...>] [--starts <v,v,...>]"
+              << " [--eps <v>] [--max-iters <n>] [--threads <n>] [--target <v>]\n";
+}
+
+std::vector<double> parseList(const char *text) {
+    std::vector<double> values;
+    std::stringstream ss(text);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        if (!item.empty()) values.push_back(std::atof(item.c_str()));
+    }
+    return values;
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--a3") == 0 && i + 1 < argc) {
+            args.a3 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--a2") == 0 && i + 1 < argc) {
+            args.a2 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--a1") == 0 && i + 1 < argc) {
+            args.a1 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--a0") == 0 && i + 1 < argc) {
+            args.a0 = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--alphas") == 0 && i + 1 < argc) {
+            args.alphas = parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--starts") == 0 && i + 1 < argc) {
+            args.starts = parseList(argv[++i]);
+        } else if (std::strcmp(argv[i], "--eps") == 0 && i + 1 < argc) {
+            args.eps = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--max-iters") == 0 && i + 1 < argc) {
+            args.maxIters = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc) {
+            args.threads = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--target") == 0 && i + 1 < argc) {
+            args.hasTarget = true;
+            args.target = std::atof(argv[++i]);
+        } else {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    return !args.alphas.empty() && !args.starts.empty();
+}
+
+class CubicObjective final : public gd::Objective {
+public:
+    CubicObjective(double a3, double a2, double a1, double a0)
+        : Objective(1), a3_(a3), a2_(a2), a1_(a1), a0_(a0) {}
+
+    double value(const gd::Vector &x) const override {
+        const double v = x[0];
+        return ((a3_ * v + a2_) * v + a1_) * v + a0_;
+    }
+
+    bool hasAnalyticGradient() const noexcept override { return true; }
+
+    gd::Vector analyticGradient(const gd::Vector &x) const override {
+        const double v = x[0];
+        return {3.0 * a3_ * v * v + 2.0 * a2_ * v + a1_};
+    }
+
+private:
+    double a3_;
+    double a2_;
+    double a1_;
+    double a0_;
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Args args;
+    if (!parseArgs(argc, argv, args)) {
+        return EXIT_FAILURE;
+    }
+
+    try {
+        CubicObjective objective(args.a3, args.a2, args.a1, args.a0);
+
+        std::vector<gd::MultiStartRun> runs;
+        for (double alpha : args.alphas) {
+            for (double x0 : args.starts) {
+                gd::MultiStartRun run;
+                run.start = {x0};
+                run.config.learningRate = alpha;
+                run.config.tolerance = args.eps;
+                run.config.maxIterations = args.maxIters;
+                runs.push_back(run);
+            }
+        }
+
+        gd::MultiStartOptions options;
+        options.threads = args.threads;
+        options.stopAtTarget = args.hasTarget;
+        options.targetValue = args.target;
+
+        gd::MultiStartRunner runner(options);
+        const gd::MultiStartStats stats = runner.run(objective, runs);
+
+        for (std::size_t i = 0; i < stats.runs.size(); ++i) {
+            const gd::MultiStartRunResult &r = stats.runs[i];
+            std::cout << "run " << i
+                      << " alpha=" << runs[i].config.learningRate
+                      << " x0=" << runs[i].start[0];
+            if (!r.started) {
+                std::cout << " skipped\n";
+                continue;
+            }
+            std::cout << " -> x=" << r.parameters[0]
+                      << " f=" << r.stats.finalValue
+                      << " iters=" << r.stats.iterations
+                      << (r.stats.converged ? " converged" : "")
+                      << (r.cancelled ? " cancelled" : "")
+                      << '\n';
+        }
+
+        std::cout << "Best value: " << stats.bestValue << " (run " << stats.bestRun << ")\n";
+        if (!stats.bestParameters.empty()) {
+            std::cout << "Best x = " << stats.bestParameters[0] << '\n';
+        }
+        std::cout << "Started " << stats.startedRuns << '/' << stats.runs.size()
+                  << ", converged " << stats.convergedRuns
+                  << ", cancelled " << stats.cancelledRuns
+                  << ", total iterations " << stats.totalIterations << std::endl;
+
+    } catch (const std::exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
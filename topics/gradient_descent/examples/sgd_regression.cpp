@@ -0,0 +1,173 @@
+#include "gd/stochastic.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Args {
+    std::size_t samples{100000};
+    std::size_t dim{8};
+    std::size_t batch{64};
+    std::size_t epochs{5};
+    double alpha{0.05};
+    double noise{0.1};
+    bool svrg{false};
+    bool noShuffle{false};
+    bool profile{false};
+    std::string samplePath; // write samples here and train from the memory map
+};
+
+void usage(const char *prog) {
+    std::cerr << "Usage: " << prog
+              << " [--samples <n>] [--dim <d>] [--batch <b>] [--epochs <e>] [--alpha <v>]"
+              << " [--noise <v>] [--svrg] [--no-shuffle] [--sample-file <path>] [--profile]\n";
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--samples") == 0 && i + 1 < argc) {
+            args.samples = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--dim") == 0 && i + 1 < argc) {
+            args.dim = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            args.batch = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--epochs") == 0 && i + 1 < argc) {
+            args.epochs = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (std::strcmp(argv[i], "--alpha") == 0 && i + 1 < argc) {
+            args.alpha = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--noise") == 0 && i + 1 < argc) {
+            args.noise = std::atof(argv[++i]);
+        } else if (std::strcmp(argv[i], "--svrg") == 0) {
+            args.svrg = true;
+        } else if (std::strcmp(argv[i], "--no-shuffle") == 0) {
+            args.noShuffle = true;
+        } else if (std::strcmp(argv[i], "--sample-file") == 0 && i + 1 < argc) {
+            args.samplePath = argv[++i];
+        } else if (std::strcmp(argv[i], "--profile") == 0) {
+            args.profile = true;
+        } else {
+            usage(argv[0]);
+            return false;
+        }
+    }
+    return args.samples > 0 && args.dim > 0;
+}
+
+// Least squares: each row is (a_1..a_d, y), f_i(w) = 0.5 * (a.w - y)^2
+class LeastSquaresObjective final : public gd::FiniteSumObjective {
+public:
+    LeastSquaresObjective(std::size_t dim, const gd::SampleSet &samples)
+        : FiniteSumObjective(dim, samples) {}
+
+    double valueOnBatch(const gd::Vector &w, const gd::SampleBatch &batch) const override {
+        double sum = 0.0;
+        for (std::size_t k = 0; k < batch.count; ++k) {
+            const double r = residual(w, batch.row(k));
+            sum += 0.5 * r * r;
+        }
+        return sum / static_cast<double>(batch.count);
+    }
+
+    void gradientOnBatch(const gd::Vector &w, const gd::SampleBatch &batch, gd::Vector &grad) const override {
+        std::fill(grad.begin(), grad.end(), 0.0);
+        for (std::size_t k = 0; k < batch.count; ++k) {
+            const double *row = batch.row(k);
+            const double r = residual(w, row);
+            for (std::size_t j = 0; j < w.size(); ++j) {
+                grad[j] += r * row[j];
+            }
+        }
+        const double scale = 1.0 / static_cast<double>(batch.count);
+        for (double &g : grad) {
+            g *= scale;
+        }
+    }
+
+private:
+    static double residual(const gd::Vector &w, const double *row) {
+        double dot = 0.0;
+        for (std::size_t j = 0; j < w.size(); ++j) {
+            dot += w[j] * row[j];
+        }
+        return dot - row[w.size()];
+    }
+};
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Args args;
+    if (!parseArgs(argc, argv, args)) {
+        return EXIT_FAILURE;
+    }
+
+    try {
+        // Synthetic data: y = a.w_true + noise
+        std::mt19937_64 rng(42);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        gd::Vector wTrue(args.dim);
+        for (double &w : wTrue) w = normal(rng);
+
+        const std::size_t width = args.dim + 1;
+        std::vector<double> data(args.samples * width);
+        for (std::size_t i = 0; i < args.samples; ++i) {
+            double *row = data.data() + i * width;
+            double y = 0.0;
+            for (std::size_t j = 0; j < args.dim; ++j) {
+                row[j] = normal(rng);
+                y += row[j] * wTrue[j];
+            }
+            row[args.dim] = y + args.noise * normal(rng);
+        }
+
+        std::unique_ptr<gd::SampleSet> samples = std::make_unique<gd::InMemorySamples>(std::move(data), width);
+        if (!args.samplePath.empty()) {
+            gd::writeSampleFile(args.samplePath, *samples);
+            samples = std::make_unique<gd::MappedSamples>(args.samplePath);
+        }
+
+        // The objective borrows *samples, which must outlive it
+        LeastSquaresObjective objective(args.dim, *samples);
+        gd::Vector w(args.dim, 0.0);
+
+        gd::OptimConfig config;
+        config.learningRate = args.alpha;
+        config.tolerance = 1e-6;
+
+        gd::StochasticConfig stochastic;
+        stochastic.batchSize = args.batch;
+        stochastic.epochs = args.epochs;
+        stochastic.shuffle = !args.noShuffle;
+        stochastic.svrg = args.svrg;
+
+        gd::StochasticTrainer trainer;
+        const gd::TrainStats stats = trainer.minimize(objective, w, config, stochastic);
+
+        double error = 0.0;
+        for (std::size_t j = 0; j < args.dim; ++j) {
+            error = std::max(error, std::abs(w[j] - wTrue[j]));
+        }
+        std::cout << "Steps: " << stats.iterations
+                  << (stats.converged ? " (converged)" : "") << '\n';
+        std::cout << "Full objective: " << objective.value(w) << '\n';
+        std::cout << "max |w - w_true| = " << error << std::endl;
+        if (args.profile) {
+            gd::writeProfile(std::cout, stats.profile);
+        }
+
+    } catch (const std::exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Checkpoint -------------------------
+// Everything Trainer::minimize needs to continue a run: the iteration about
+// to start, the parameters and the (possibly callback-mutated) config.
+// `optimizerState` carries optimizer internals (FISTA momentum); plain
+// gradient descent is stateless and leaves it empty.
+struct Checkpoint {
+    std::uint64_t iteration = 0;
+    Vector parameters;
+    OptimConfig config;
+    std::vector<double> optimizerState;
+};
+
+// Compact binary snapshot ("GDCKPT" header, raw doubles, FNV-1a checksum).
+// The file is written to "<path>.tmp" and renamed, so a crash mid-write never
+// leaves a torn checkpoint behind.
+void saveCheckpoint(const std::string& path, const Checkpoint& checkpoint);
+Checkpoint loadCheckpoint(const std::string& path);
+
+// Snapshots the state at the start of every `period`-th iteration and writes
+// it on a background thread; the training loop only pays for copying x. If a
+// write is still running, the pending snapshot is replaced by the newer one.
+// Register it before callbacks that mutate the config (e.g. LearningRateDecay)
+// so the snapshot holds the config as it was when the iteration started.
+class CheckpointCallback final : public Callback {
+public:
+    explicit CheckpointCallback(std::string path, std::size_t period = 100);
+    ~CheckpointCallback() override;
+
+    void onIteration(TrainerState& state) override;
+
+    // Blocks until every snapshot taken so far is on disk; rethrows write errors
+    void flush();
+
+private:
+    void writerLoop();
+
+    std::string path_;
+    std::size_t period_;
+
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable idle_;
+    std::unique_ptr<Checkpoint> pending_;
+    bool writing_ = false;
+    bool closing_ = false;
+    std::string error_;
+    std::thread writer_;
+};
+
+} // namespace gd
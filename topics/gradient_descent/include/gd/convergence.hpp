@@ -0,0 +1,95 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Stopping Criteria -------------------------
+// Stopping criteria are callbacks that call TrainerState::requestStop with
+// their own StopReason, so they compose by simply registering several: the
+// run ends as soon as any of them fires (in registration order) and
+// TrainStats::stopReason says which one. They complement the built-in
+// OptimConfig::tolerance test on the gradient inf-norm. Each keeps a little
+// per-run state and resets itself when a new run starts (iteration does not
+// increase), so one instance can serve consecutive runs but not concurrent
+// ones.
+
+// Stops when the objective moved by at most `absoluteTolerance`, or by at
+// most `relativeTolerance * |f_old|`, over the last `window` iterations.
+// A tolerance of 0 disables that test.
+class ValueChangeStop final : public Callback {
+public:
+    ValueChangeStop(std::size_t window, double absoluteTolerance, double relativeTolerance = 0.0);
+    void onIteration(TrainerState& state) override;
+
+private:
+    std::size_t window_;
+    double absoluteTolerance_;
+    double relativeTolerance_;
+    std::vector<double> history_; // ring of the last window + 1 values
+    std::size_t seen_ = 0;
+    std::size_t lastIteration_ = std::numeric_limits<std::size_t>::max();
+};
+
+// Stops when the last step ||x_k - x_{k-1}||_2 is below `tolerance`
+class StepSizeStop final : public Callback {
+public:
+    explicit StepSizeStop(double tolerance);
+    void onIteration(TrainerState& state) override;
+
+private:
+    double tolerance_;
+    Vector previous_;
+    bool havePrevious_ = false;
+    std::size_t lastIteration_ = std::numeric_limits<std::size_t>::max();
+};
+
+// Stops when ||grad f(x)||_2 is below `tolerance`. Under a proximal Trainer
+// the raw gradient need not vanish at a constrained or L1 optimum, so the
+// gradient mapping ||x - prox(x - lr * grad)||_2 / lr is tested instead.
+class GradientNormStop final : public Callback {
+public:
+    explicit GradientNormStop(double tolerance);
+    void onIteration(TrainerState& state) override;
+
+private:
+    double tolerance_;
+};
+
+// Stops once `seconds` of wall-clock time have passed since the first
+// iteration of the run
+class TimeBudgetStop final : public Callback {
+public:
+    explicit TimeBudgetStop(double seconds);
+    void onIteration(TrainerState& state) override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::duration budget_;
+    Clock::time_point start_;
+    std::size_t lastIteration_ = std::numeric_limits<std::size_t>::max();
+};
+
+// Stops before the next iteration would push the value or gradient
+// evaluation count (TrainProfile, finite-difference probes included) past
+// its budget, assuming it costs as much as the last one. 0 = unlimited.
+class EvaluationBudgetStop final : public Callback {
+public:
+    explicit EvaluationBudgetStop(std::size_t maxValueEvaluations, std::size_t maxGradientEvaluations = 0);
+    void onIteration(TrainerState& state) override;
+
+private:
+    std::size_t maxValueEvaluations_;
+    std::size_t maxGradientEvaluations_;
+    std::size_t lastValueEvaluations_ = 0;
+    std::size_t lastGradientEvaluations_ = 0;
+    std::size_t lastIteration_ = std::numeric_limits<std::size_t>::max();
+};
+
+} // namespace gd
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+namespace gd {
+namespace fixed {
+
+// Compile-time fixed-dimension counterpart of the gd::Objective / gd::Trainer
+// pair. Vectors are std::array, objectives bind statically through CRTP and
+// callbacks are template arguments, so small problems (1-8 dims) compile down
+// to straight-line code with no heap allocation or virtual dispatch.
+
+template <std::size_t N>
+using Vector = std::array<double, N>;
+
+// ------------------------- Objective -------------------------
+// Derived must provide:
+//     double value(const Vector<N>& x) const;
+// and may provide an analytic gradient by declaring
+//     static constexpr bool hasAnalyticGradient = true;
+//     Vector<N> analyticGradient(const Vector<N>& x) const;
+// Same thread-safety contract as gd::Objective.
+template <class Derived, std::size_t N>
+class Objective {
+public:
+    static_assert(N > 0, "Objective dimension must be positive");
+
+    static constexpr std::size_t dimension = N;
+    static constexpr bool hasAnalyticGradient = false;
+
+    explicit Objective(double finiteDifferenceStep = 1e-6) noexcept
+        : finiteDifferenceStep_(finiteDifferenceStep > 0.0 ? finiteDifferenceStep : 1e-6) {}
+
+    // Uses Derived::analyticGradient if declared, otherwise central differences
+    Vector<N> gradient(const Vector<N>& x) const {
+        if constexpr (Derived::hasAnalyticGradient) {
+            return self().analyticGradient(x);
+        } else {
+            Vector<N> grad{};
+            Vector<N> xPerturbed = x;
+            const double step = finiteDifferenceStep_;
+            for (std::size_t i = 0; i < N; ++i) {
+                const double original = xPerturbed[i];
+                xPerturbed[i] = original + step;
+                const double forward = self().value(xPerturbed);
+                xPerturbed[i] = original - step;
+                const double backward = self().value(xPerturbed);
+                grad[i] = (forward - backward) / (2.0 * step);
+                xPerturbed[i] = original;
+            }
+            return grad;
+        }
+    }
+
+    void setFiniteDifferenceStep(double step) noexcept {
+        if (step > 0.0) {
+            finiteDifferenceStep_ = step;
+        }
+    }
+    double finiteDifferenceStep() const noexcept { return finiteDifferenceStep_; }
+
+private:
+    const Derived& self() const noexcept { return static_cast<const Derived&>(*this); }
+
+    double finiteDifferenceStep_;
+};
+
+// ------------------------- Callbacks API -------------------------
+template <std::size_t N>
+struct TrainerState {
+    std::size_t iteration;
+    double value;
+    double gradNormInf;
+    Vector<N>& parameters;
+    Vector<N>& gradient;
+    OptimConfig& config;
+    bool& stop;
+    StopReason& stopReason;
+
+    // Same contract as gd::TrainerState::requestStop
+    void requestStop(StopReason reason) noexcept {
+        if (!stop) {
+            stop = true;
+            stopReason = reason;
+        }
+    }
+};
+
+// Default callback: does nothing and inlines away
+struct NoCallback {
+    template <class State>
+    void operator()(State&) const noexcept {}
+};
+
+// ------------------------- Trainer -------------------------
+template <std::size_t N>
+class Trainer {
+public:
+    // Same loop and stopping rules as gd::Trainer::minimize. `onIteration` is
+    // any callable taking TrainerState<N>& (lambda, functor, NoCallback).
+    template <class Obj, class OnIteration = NoCallback>
+    TrainStats minimize(Obj& objective,
+                        Vector<N>& x,
+                        OptimConfig& config,
+                        OnIteration&& onIteration = OnIteration{}) const {
+        static_assert(Obj::dimension == N, "Objective dimension mismatch");
+
+        config.applyDefaults();
+        if (objective.finiteDifferenceStep() != config.numericGradientStep) {
+            objective.setFiniteDifferenceStep(config.numericGradientStep);
+        }
+
+        TrainStats stats;
+        Vector<N> grad{};
+        bool stop = false;
+        StopReason stopReason = StopReason::Callback;
+
+        for (std::size_t iter = 0; iter < config.maxIterations; ++iter) {
+            const double value = objective.value(x);
+            grad = objective.gradient(x);
+            const double gradNorm = infNorm(grad);
+
+            stats.iterations = iter + 1;
+            stats.finalValue = value;
+            stats.finalGradNorm = gradNorm;
+
+            TrainerState<N> state{iter, value, gradNorm, x, grad, config, stop, stopReason};
+            onIteration(state);
+
+            if (stop) {
+                stats.stoppedEarly = true;
+                stats.stopReason = stopReason;
+                break;
+            }
+
+            if (gradNorm < config.tolerance) {
+                stats.converged = true;
+                stats.stopReason = StopReason::GradientTolerance;
+                break;
+            }
+
+            const double lr = config.learningRate;
+            for (std::size_t i = 0; i < N; ++i) {
+                x[i] -= lr * grad[i];
+            }
+        }
+
+        return stats;
+    }
+
+    static double infNorm(const Vector<N>& values) noexcept {
+        double norm = 0.0;
+        for (double v : values) {
+            const double a = std::fabs(v);
+            norm = a > norm ? a : norm;
+        }
+        return norm;
+    }
+};
+
+} // namespace fixed
+} // namespace gd
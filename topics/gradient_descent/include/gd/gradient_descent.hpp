@@ -1,5 +1,7 @@
 #pragma once
 
+#include "gd/profiling.hpp"
+
 #include <cstddef>
 #include <iosfwd>
 #include <memory>
@@ -16,8 +18,14 @@ using Vector = std::vector<double>;
 class Objective;
 struct OptimConfig;
 struct TrainerState;
+struct Checkpoint;
+class ProximalOperator;
 
 // ------------------------- Objective -------------------------
+// Thread-safety contract: value(), analyticGradient() and gradient() are const
+// and must be safe to call concurrently on one shared instance (no mutable
+// caches without synchronisation). MultiStartRunner relies on this. Mutators
+// such as setFiniteDifferenceStep() must not race with evaluations.
 class Objective {
 public:
     explicit Objective(std::size_t dimension, double finiteDifferenceStep = 1e-6);
@@ -37,8 +45,17 @@ public:
     // Public gradient: uses analytic version if available, otherwise central differences
     Vector gradient(const Vector& x) const;
 
+    // Returns f(x) and writes its gradient into `grad` (resized to
+    // dimension()). The default calls value() and gradient().
+    virtual double valueAndGradient(const Vector& x, Vector& grad) const;
+
+    // Whether valueAndGradient() shares work between the two (Trainer then
+    // makes one fused call per iteration instead of value() + gradient())
+    virtual bool hasFusedGradient() const noexcept { return false; }
+
     // Finite-difference step control
     void setFiniteDifferenceStep(double step) noexcept;
+    double finiteDifferenceStep() const noexcept { return finiteDifferenceStep_; }
 
 protected:
     // Internal dimension guard (intentionally protected)
@@ -59,6 +76,24 @@ struct OptimConfig {
     void applyDefaults();
 };
 
+// ------------------------- Stop Reasons -------------------------
+// Why a run ended (TrainStats::stopReason)
+enum class StopReason {
+    MaxIterations,        // ran out of iterations (or epochs)
+    GradientTolerance,    // gradient inf-norm (gradient mapping) < OptimConfig::tolerance
+    Callback,             // a callback set `stop` without giving a reason
+    TargetValue,          // EarlyStop
+    AbsoluteValueChange,  // ValueChangeStop
+    RelativeValueChange,  // ValueChangeStop
+    StepSize,             // StepSizeStop
+    GradientNorm,         // GradientNormStop
+    TimeBudget,           // TimeBudgetStop
+    EvaluationBudget,     // EvaluationBudgetStop
+    Cancelled             // MultiStartRunner cancelled the run
+};
+
+std::string stopReasonToString(StopReason reason);
+
 // ------------------------- Callbacks API -------------------------
 struct TrainerState {
     std::size_t iteration;
@@ -69,6 +104,25 @@ struct TrainerState {
     Objective& objective;
     OptimConfig& config;
     bool& stop;
+    StopReason& stopReason;
+    const TrainProfile& profile; // counters and phase timings so far
+    const Vector& optimizerState; // e.g. FISTA momentum; what a Checkpoint stores
+    const Vector* proximalPoint = nullptr; // proximal mode: prox(x - lr * gradient)
+    double proximalLearningRate = 0.0;     // the lr proximalPoint was computed with
+    bool iterateModified = false; // see markModified()
+
+    // Sets `stop` and records why; the first request in an iteration wins
+    void requestStop(StopReason reason) noexcept {
+        if (!stop) {
+            stop = true;
+            stopReason = reason;
+        }
+    }
+
+    // Callbacks that write `parameters` or `gradient` must call this: the
+    // proximal trainer otherwise reuses the step it computed before the
+    // callbacks ran. Learning-rate changes are detected automatically.
+    void markModified() noexcept { iterateModified = true; }
 };
 
 struct Callback {
@@ -76,21 +130,35 @@ struct Callback {
     virtual void onIteration(TrainerState& state) = 0; // non-const so callbacks may mutate state
 };
 
-// Logs to CSV file
+// Logs to CSV file every `stride`-th iteration. Rows are formatted with
+// std::to_chars into preallocated buffers; full buffers go to a background
+// writer thread through a lock-free SPSC queue. The training loop waits
+// only when the writer falls a full ring (4 buffers) behind, i.e. when rows
+// are produced faster than the disk takes them. The tail is written when
+// the logger is destroyed.
+// With `append` (for Trainer::resume) an existing file with the same
+// columns keeps its rows from before the first iteration logged now; later
+// rows, e.g. ones written after the last checkpoint, are replaced.
 class CsvLogger final : public Callback {
 public:
-    explicit CsvLogger(std::string path);
+    explicit CsvLogger(std::string path,
+                       std::size_t stride = 1,
+                       std::size_t bufferSize = 1 << 16,
+                       bool append = false);
     ~CsvLogger() override;
 
     void onIteration(TrainerState& state) override;
 
 private:
-    void ensureStream();
+    class Writer;
+
+    void open(const TrainerState& state);
 
     std::string path_;
-    std::unique_ptr<std::ostream> ownedStream_;
-    std::ostream* stream_ = nullptr;
-    bool wroteHeader_ = false;
+    std::size_t stride_;
+    std::size_t bufferSize_;
+    bool append_;
+    std::unique_ptr<Writer> writer_;
 };
 
 // Logs to provided ostream (default: std::cout via defaultStream())
@@ -127,6 +195,17 @@ private:
     double targetValue_;
 };
 
+// Prints the profile accumulated so far every `period` iterations
+class ProfilerCallback final : public Callback {
+public:
+    explicit ProfilerCallback(std::ostream& out = ConsoleLogger::defaultStream(), std::size_t period = 100);
+    void onIteration(TrainerState& state) override;
+
+private:
+    std::ostream* stream_;
+    std::size_t period_;
+};
+
 // ------------------------- Optimizer & Trainer -------------------------
 class GradientDescentOptimizer {
 public:
@@ -137,18 +216,53 @@ struct TrainStats {
     std::size_t iterations = 0;
     double finalValue = 0.0;
     double finalGradNorm = 0.0;
-    bool converged = false;
-    bool stoppedEarly = false;
+    bool converged = false;       // gradient tolerance reached
+    bool stoppedEarly = false;    // a callback (e.g. a stopping criterion) stopped the run
+    StopReason stopReason = StopReason::MaxIterations;
+    TrainProfile profile;
 };
 
+// Without a proximal operator, Trainer runs plain gradient descent. With one
+// it solves min f(x) + g(x) by proximal gradient steps
+//     x <- prox_{lr*g}(x - lr * grad f(x)),
+// optionally with FISTA momentum (`accelerate`). In that mode gradNormInf is
+// the inf-norm of the gradient mapping (x - prox_{lr*g}(x - lr*grad)) / lr,
+// which vanishes at constrained/regularised optima, `value` is f alone, and
+// on return x is the last proximal point (feasible for projections). With
+// FISTA, callbacks see the extrapolated point the gradient is taken at.
 class Trainer {
 public:
+    Trainer() = default;
+    explicit Trainer(std::shared_ptr<const ProximalOperator> proximal, bool accelerate = false);
+
     TrainStats minimize(Objective& objective,
                         Vector& x,
                         OptimConfig& config,
                         const std::vector<std::shared_ptr<Callback>>& callbacks) const;
 
+    // Continues a run from a checkpoint (see gd/checkpoint.hpp): restores `x`,
+    // the learning rate and the finite-difference step from it, keeps
+    // `config`'s maxIterations and tolerance, and iterates from
+    // checkpoint.iteration. With the original maxIterations and tolerance
+    // this reproduces the uninterrupted run bit for bit.
+    TrainStats resume(Objective& objective,
+                      const Checkpoint& checkpoint,
+                      Vector& x,
+                      OptimConfig& config,
+                      const std::vector<std::shared_ptr<Callback>>& callbacks) const;
+
     static double infNorm(const Vector& values);
+
+private:
+    TrainStats run(Objective& objective,
+                   Vector& x,
+                   OptimConfig& config,
+                   const std::vector<std::shared_ptr<Callback>>& callbacks,
+                   std::size_t firstIteration,
+                   const Vector& optimizerState) const;
+
+    std::shared_ptr<const ProximalOperator> proximal_;
+    bool accelerate_ = false;
 };
 
 } // namespace gd
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+#include "gd/thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace gd {
+
+// ------------------------- Vector Kernels -------------------------
+// Dense kernels for large vectors. Each works on fixed blocks of
+// kKernelBlock elements with several independent accumulators so the inner
+// loops vectorise. With a pool, blocks are spread across threads once
+// n >= kParallelThreshold. Block boundaries depend only on n and partial
+// results are combined in block order, so every result is bit-identical with
+// or without a pool and whatever the thread count.
+
+constexpr std::size_t kKernelBlock = std::size_t{1} << 15;
+constexpr std::size_t kParallelThreshold = 2 * kKernelBlock;
+
+// y += alpha * x
+void axpy(double alpha, const double* x, double* y, std::size_t n, ThreadPool* pool = nullptr);
+double dot(const double* x, const double* y, std::size_t n, ThreadPool* pool = nullptr);
+double norm2(const double* x, std::size_t n, ThreadPool* pool = nullptr);
+double normInf(const double* x, std::size_t n, ThreadPool* pool = nullptr);
+
+void axpy(double alpha, const Vector& x, Vector& y, ThreadPool* pool = nullptr);
+double dot(const Vector& x, const Vector& y, ThreadPool* pool = nullptr);
+double norm2(const Vector& x, ThreadPool* pool = nullptr);
+double normInf(const Vector& x, ThreadPool* pool = nullptr);
+
+// Process-wide pool (hardware concurrency) used by Trainer for large vectors
+ThreadPool& defaultThreadPool();
+
+// ------------------------- Parallel For -------------------------
+// Calls fn(first, last) on consecutive ranges of at most `grain` indices
+// covering [begin, end). The caller runs ranges too and, while waiting, helps
+// with other queued pool work, so it is safe to call from inside a pool task
+// (e.g. an objective's gradient during a MultiStartRunner run). Rethrows the
+// first exception thrown by fn.
+void parallelForRanges(ThreadPool& pool,
+                       std::size_t begin,
+                       std::size_t end,
+                       std::size_t grain,
+                       const std::function<void(std::size_t, std::size_t)>& fn);
+
+// Convenience form calling fn(i) for every index
+template <class Fn>
+void parallelFor(ThreadPool& pool, std::size_t begin, std::size_t end, std::size_t grain, Fn&& fn) {
+    parallelForRanges(pool, begin, end, grain, [&fn](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            fn(i);
+        }
+    });
+}
+
+} // namespace gd
@@ -0,0 +1,72 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+#include "gd/thread_pool.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Multi-start -------------------------
+// One independent Trainer::minimize run: its own start point and config.
+struct MultiStartRun {
+    Vector start;
+    OptimConfig config;   // numericGradientStep must be the same for every run
+};
+
+struct MultiStartOptions {
+    std::size_t threads = 0;        // 0 -> hardware concurrency
+    bool stopAtTarget = false;      // cancel every run once any reaches targetValue
+    double targetValue = 0.0;
+};
+
+struct MultiStartRunResult {
+    Vector parameters;
+    TrainStats stats;
+    bool started = false;       // false if cancelled before it was scheduled
+    bool reachedTarget = false;
+    bool cancelled = false;     // stopped because another run reached the target
+};
+
+struct MultiStartStats {
+    std::vector<MultiStartRunResult> runs; // same order as the input runs
+    std::size_t bestRun = 0;
+    double bestValue = std::numeric_limits<double>::infinity();
+    Vector bestParameters;
+    double meanFinalValue = 0.0;   // over started runs
+    double worstFinalValue = -std::numeric_limits<double>::infinity();
+    std::size_t startedRuns = 0;
+    std::size_t convergedRuns = 0;
+    std::size_t cancelledRuns = 0;
+    std::size_t totalIterations = 0;
+    bool targetReached = false;
+};
+
+// Builds the callbacks for one run. Called on the worker thread executing the
+// run, so stateful callbacks (loggers, LR decay) are never shared.
+using CallbackFactory = std::function<std::vector<std::shared_ptr<Callback>>(std::size_t runIndex)>;
+
+// Runs many minimize() calls in-process on a work-stealing pool. The objective
+// is shared read-only by all runs (see the Objective thread-safety contract);
+// its finite-difference step is fixed up front, so run() throws
+// std::invalid_argument if the runs' numericGradientStep values differ.
+class MultiStartRunner {
+public:
+    explicit MultiStartRunner(MultiStartOptions options = {});
+
+    MultiStartStats run(Objective& objective,
+                        std::vector<MultiStartRun> runs,
+                        const CallbackFactory& makeCallbacks = {});
+
+    const MultiStartOptions& options() const noexcept { return options_; }
+
+private:
+    MultiStartOptions options_;
+    ThreadPool pool_;
+};
+
+} // namespace gd
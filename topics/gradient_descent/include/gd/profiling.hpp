@@ -0,0 +1,107 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// Set to 1 (CMake: -DGD_PROFILING=ON) to compile per-phase timers and the
+// run clock into the trainers. Evaluation counters are always kept; they
+// are free.
+#ifndef GD_PROFILING
+#define GD_PROFILING 0
+#endif
+
+namespace gd {
+
+// ------------------------- Phase Profile -------------------------
+// Log-linear latency histogram (4 sub-buckets per power of two, ~19% bucket
+// width) plus count/total/max. Fixed size, never allocates.
+class PhaseProfile {
+public:
+    void record(std::uint64_t nanoseconds) noexcept;
+
+    std::uint64_t count() const noexcept { return count_; }
+    double totalSeconds() const noexcept { return static_cast<double>(totalNanoseconds_) * 1e-9; }
+    double maxSeconds() const noexcept { return static_cast<double>(maxNanoseconds_) * 1e-9; }
+    double meanSeconds() const noexcept;
+
+    // Upper edge of the bucket holding the q-quantile, q in [0, 1]
+    double percentileSeconds(double q) const noexcept;
+    double p50Seconds() const noexcept { return percentileSeconds(0.50); }
+    double p99Seconds() const noexcept { return percentileSeconds(0.99); }
+
+private:
+    static constexpr unsigned kSubBits = 2;
+    static constexpr unsigned kMaxExponent = 44; // ~4.9 h; longer samples are clamped
+    static constexpr std::size_t kBuckets = (kMaxExponent - kSubBits + 2) << kSubBits;
+
+    static std::size_t bucketOf(std::uint64_t nanoseconds) noexcept;
+    static std::uint64_t bucketUpperEdge(std::size_t bucket) noexcept;
+
+    std::array<std::uint64_t, kBuckets> buckets_{};
+    std::uint64_t count_ = 0;
+    std::uint64_t totalNanoseconds_ = 0;
+    std::uint64_t maxNanoseconds_ = 0;
+};
+
+// Where a Trainer or StochasticTrainer run spent its time. When GD_PROFILING
+// is 0 only the counters exist: the phase histograms (~1.4 KB each) are not
+// carried by every TrainStats.
+struct TrainProfile {
+    std::size_t valueEvaluations = 0;    // includes finite-difference probes
+    std::size_t gradientEvaluations = 0;
+#if GD_PROFILING
+    PhaseProfile value;
+    PhaseProfile gradient;
+    PhaseProfile callbacks;
+    PhaseProfile step;
+    double totalSeconds = 0.0;
+#endif
+};
+
+// ------------------------- Phase Timer -------------------------
+enum class Phase { Value, Gradient, Callbacks, Step };
+
+// Records the lifetime of the scope into a phase of `profile`; compiles to
+// nothing when GD_PROFILING is 0 (TrainProfile then has no phases). Shared
+// by Trainer and StochasticTrainer so both fill the same four phases.
+class PhaseTimer {
+public:
+#if GD_PROFILING
+    PhaseTimer(TrainProfile& profile, Phase phase) noexcept
+        : phase_(select(profile, phase)), start_(std::chrono::steady_clock::now()) {}
+
+    ~PhaseTimer() {
+        const auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start_);
+        phase_.record(static_cast<std::uint64_t>(elapsed.count()));
+    }
+#else
+    PhaseTimer(TrainProfile&, Phase) noexcept {}
+#endif
+
+    PhaseTimer(const PhaseTimer&) = delete;
+    PhaseTimer& operator=(const PhaseTimer&) = delete;
+
+private:
+#if GD_PROFILING
+    static PhaseProfile& select(TrainProfile& profile, Phase phase) noexcept {
+        switch (phase) {
+            case Phase::Value: return profile.value;
+            case Phase::Gradient: return profile.gradient;
+            case Phase::Callbacks: return profile.callbacks;
+            case Phase::Step:
+            default: return profile.step;
+        }
+    }
+
+    PhaseProfile& phase_;
+    std::chrono::steady_clock::time_point start_;
+#endif
+};
+
+// Human-readable table: one line per phase with count, total, mean, p50, p99, max
+void writeProfile(std::ostream& out, const TrainProfile& profile);
+
+} // namespace gd
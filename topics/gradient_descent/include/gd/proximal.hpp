@@ -0,0 +1,67 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+
+#include <cstddef>
+
+namespace gd {
+
+// ------------------------- Proximal Operators -------------------------
+// Composite problems min f(x) + g(x): f is the smooth Objective, g a simple
+// convex term (a constraint set's indicator or a regulariser) handled through
+// its proximal operator
+//     prox_{step*g}(x) = argmin_z g(z) + ||z - x||^2 / (2 * step).
+// For an indicator this is the Euclidean projection onto the set. Operators
+// are stateless and apply() is const, so one instance may be shared by
+// concurrent runs.
+class ProximalOperator {
+public:
+    virtual ~ProximalOperator() = default;
+
+    // Replaces x with prox_{step*g}(x); `step` is the current learning rate
+    virtual void apply(Vector& x, double step) const = 0;
+};
+
+// lower <= x <= upper, per coordinate. Bounds may be +-infinity.
+class BoxProjection final : public ProximalOperator {
+public:
+    BoxProjection(double lower, double upper);     // same bounds for every coordinate
+    BoxProjection(Vector lower, Vector upper);      // one bound pair per coordinate
+    void apply(Vector& x, double step) const override;
+
+private:
+    Vector lower_;
+    Vector upper_;
+};
+
+// Scaled probability simplex {x >= 0, sum(x) = radius}
+class SimplexProjection final : public ProximalOperator {
+public:
+    explicit SimplexProjection(double radius = 1.0);
+    void apply(Vector& x, double step) const override;
+
+private:
+    double radius_;
+};
+
+// g(x) = lambda * ||x||_1: soft thresholding by step * lambda
+class L1Proximal final : public ProximalOperator {
+public:
+    explicit L1Proximal(double lambda);
+    void apply(Vector& x, double step) const override;
+
+private:
+    double lambda_;
+};
+
+// Euclidean ball ||x||_2 <= radius
+class L2BallProjection final : public ProximalOperator {
+public:
+    explicit L2BallProjection(double radius = 1.0);
+    void apply(Vector& x, double step) const override;
+
+private:
+    double radius_;
+};
+
+} // namespace gd
@@ -0,0 +1,135 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+#include "gd/thread_pool.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Sample Sets -------------------------
+// Samples are fixed-width rows of doubles stored contiguously (row-major).
+// What a row means (features, label, weight...) is up to the objective.
+class SampleSet {
+public:
+    virtual ~SampleSet() = default;
+
+    virtual std::size_t sampleCount() const noexcept = 0;
+    virtual std::size_t width() const noexcept = 0;
+    virtual const double* data() const noexcept = 0;
+
+    const double* sample(std::size_t index) const noexcept { return data() + index * width(); }
+};
+
+class InMemorySamples final : public SampleSet {
+public:
+    InMemorySamples(std::vector<double> data, std::size_t width);
+
+    std::size_t sampleCount() const noexcept override { return count_; }
+    std::size_t width() const noexcept override { return width_; }
+    const double* data() const noexcept override { return data_.data(); }
+
+private:
+    std::vector<double> data_;
+    std::size_t width_;
+    std::size_t count_;
+};
+
+// Read-only memory map of a sample file: 32-byte header ("GDSAMPL", uint64
+// count, uint64 width, reserved) followed by count x width float64 values.
+class MappedSamples final : public SampleSet {
+public:
+    explicit MappedSamples(const std::string& path);
+    ~MappedSamples() override;
+
+    MappedSamples(const MappedSamples&) = delete;
+    MappedSamples& operator=(const MappedSamples&) = delete;
+
+    std::size_t sampleCount() const noexcept override { return count_; }
+    std::size_t width() const noexcept override { return width_; }
+    const double* data() const noexcept override { return data_; }
+
+private:
+    void* mapping_ = nullptr;
+    std::size_t mappingSize_ = 0;
+    const double* data_ = nullptr;
+    std::size_t count_ = 0;
+    std::size_t width_ = 0;
+};
+
+void writeSampleFile(const std::string& path, const SampleSet& samples);
+
+// ------------------------- Finite-sum Objective -------------------------
+// A batch is `count` rows of the sample set, contiguous in `rows`.
+// `indices[k]` is the sample index of row k.
+struct SampleBatch {
+    const double* rows = nullptr;
+    const std::size_t* indices = nullptr;
+    std::size_t count = 0;
+    std::size_t width = 0;
+
+    const double* row(std::size_t k) const noexcept { return rows + k * width; }
+};
+
+// f(x) = (1/n) * sum_i f_i(x) over the rows of a SampleSet. Concrete
+// objectives implement the per-batch mean value and gradient; the full
+// value()/gradient() are derived by sweeping the whole set in chunks.
+//
+// The objective borrows `samples`: it keeps a pointer, not a copy, so the
+// SampleSet must outlive the objective and every trainer run that uses it.
+// Passing a temporary (e.g. `Obj(dim, InMemorySamples(...))`) leaves a
+// dangling pointer.
+class FiniteSumObjective : public Objective {
+public:
+    FiniteSumObjective(std::size_t dimension, const SampleSet& samples);
+
+    const SampleSet& samples() const noexcept { return *samples_; }
+
+    // Mean of f_i over the batch
+    virtual double valueOnBatch(const Vector& x, const SampleBatch& batch) const = 0;
+
+    // Mean of grad f_i over the batch, written to `grad` (already sized to dimension())
+    virtual void gradientOnBatch(const Vector& x, const SampleBatch& batch, Vector& grad) const = 0;
+
+    double value(const Vector& x) const override;
+    Vector analyticGradient(const Vector& x) const override;
+    bool hasAnalyticGradient() const noexcept override { return true; }
+
+private:
+    const SampleSet* samples_;
+};
+
+// ------------------------- Mini-batch Trainer -------------------------
+struct StochasticConfig {
+    std::size_t batchSize = 64;
+    std::size_t epochs = 10;
+    bool shuffle = true;            // reshuffle the sample order every epoch
+    bool prefetch = true;           // assemble the next batch on a background thread
+    std::uint64_t seed = 0;
+    bool svrg = false;              // SVRG variance reduction (full gradient per epoch)
+    bool evaluateEachEpoch = false; // full value/gradient at epoch start (always on with svrg)
+
+    void applyDefaults();
+};
+
+// Runs mini-batch SGD (optionally SVRG) on a FiniteSumObjective. Uses
+// OptimConfig::learningRate, and OptimConfig::tolerance against the full
+// gradient whenever one is evaluated; `epochs` bounds the run instead of
+// maxIterations. Callbacks see one TrainerState per batch step, with the
+// batch value and batch gradient. With GD_PROFILING the full and batch
+// evaluations, callbacks and updates are timed into the same phases as
+// Trainer; waiting on the batch loader is counted only in the total.
+class StochasticTrainer {
+public:
+    TrainStats minimize(FiniteSumObjective& objective,
+                        Vector& x,
+                        OptimConfig& config,
+                        StochasticConfig stochastic,
+                        const std::vector<std::shared_ptr<Callback>>& callbacks = {}) const;
+};
+
+} // namespace gd
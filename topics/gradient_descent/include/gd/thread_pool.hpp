@@ -0,0 +1,69 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Thread Pool -------------------------
+// Work-stealing pool: every worker owns a deque, pops its own work from the
+// back and steals from the front of the other deques when it runs dry.
+// Tasks submitted from inside a task go to the submitting worker's deque.
+class ThreadPool {
+public:
+    using Task = std::function<void()>;
+
+    explicit ThreadPool(std::size_t threadCount = 0); // 0 -> hardware concurrency
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t size() const noexcept { return threads_.size(); }
+
+    void submit(Task task);
+
+    // Blocks until every submitted task has finished. The calling thread helps
+    // executing queued tasks meanwhile. Rethrows the first exception a task threw.
+    // Must not be called from inside a pool task.
+    void wait();
+
+    // Runs one queued task on the calling thread, if there is one. Lets a
+    // thread that waits for its own tasks (parallelFor) help instead of idling.
+    bool runPendingTask();
+
+private:
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    bool tryPop(std::size_t index, Task& task);
+    bool trySteal(std::size_t index, Task& task);
+    bool tryAcquire(std::size_t index, Task& task);
+    void runTask(Task& task);
+    void workerLoop(std::size_t index);
+
+    std::vector<std::unique_ptr<WorkerQueue>> queues_;
+    std::vector<std::thread> threads_;
+
+    std::mutex stateMutex_;
+    std::condition_variable workAvailable_;
+    std::condition_variable allDone_;
+    std::size_t queued_ = 0;  // tasks sitting in a deque (guarded by stateMutex_)
+    std::size_t pending_ = 0; // tasks submitted but not finished (guarded by stateMutex_)
+    bool shuttingDown_ = false;
+    std::exception_ptr firstError_;
+
+    std::atomic<std::size_t> nextQueue_{0};
+};
+
+} // namespace gd
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace gd {
+
+// ------------------------- Binary Trajectory Format -------------------------
+// File = 64-byte TrajectoryHeader followed by fixed-size rows:
+//     uint64 iteration, then value, grad_norm_inf, lr, x1..xN
+// The scalars are float64 or float32 depending on the encoding. With
+// DeltaFloat32 the x columns hold float32 differences to the previous row's
+// decoded parameters (the first row is relative to zero); the encoder tracks
+// the decoded values so rounding never accumulates. Host byte order
+// (little-endian on every platform we build for). The row count is derived
+// from the file size, so a truncated file from a killed run stays readable.
+
+enum class TrajectoryEncoding : std::uint32_t {
+    Float64 = 0,
+    Float32 = 1,
+    DeltaFloat32 = 2
+};
+
+struct TrajectoryHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t encoding;
+    std::uint64_t dimension;
+    std::uint64_t stride;
+    std::uint64_t rowBytes;
+    std::uint64_t reserved[3];
+};
+static_assert(sizeof(TrajectoryHeader) == 64, "TrajectoryHeader must stay 64 bytes");
+
+struct TrajectoryRecord {
+    std::uint64_t iteration = 0;
+    double value = 0.0;
+    double gradNormInf = 0.0;
+    double learningRate = 0.0;
+    Vector parameters;
+};
+
+// Writes every `stride`-th iteration in the binary trajectory format. With
+// `append` (for Trainer::resume) an existing file written with the same
+// encoding, dimension and stride keeps its rows from before the first
+// iteration logged now; later rows are replaced.
+class TrajectoryLogger final : public Callback {
+public:
+    explicit TrajectoryLogger(std::string path,
+                              TrajectoryEncoding encoding = TrajectoryEncoding::Float64,
+                              std::size_t stride = 1,
+                              std::size_t bufferSize = 1 << 16,
+                              bool append = false);
+    ~TrajectoryLogger() override;
+
+    void onIteration(TrainerState& state) override;
+
+private:
+    void open(std::size_t dimension, std::uint64_t firstIteration);
+    bool reopen(std::uint64_t firstIteration);
+    void flushBuffer();
+
+    std::string path_;
+    TrajectoryEncoding encoding_;
+    std::size_t stride_;
+    std::size_t bufferSize_;
+    bool append_;
+    std::ofstream file_;
+    std::vector<char> buffer_;
+    std::size_t used_ = 0;
+    std::size_t dimension_ = 0;
+    std::size_t rowBytes_ = 0;
+    Vector decoded_; // DeltaFloat32: parameters as the reader will see them
+};
+
+// Memory-maps a trajectory file for sequential decoding
+class TrajectoryReader {
+public:
+    explicit TrajectoryReader(const std::string& path);
+    ~TrajectoryReader();
+
+    TrajectoryReader(const TrajectoryReader&) = delete;
+    TrajectoryReader& operator=(const TrajectoryReader&) = delete;
+
+    std::size_t dimension() const noexcept { return dimension_; }
+    std::size_t rowCount() const noexcept { return rowCount_; }
+    std::size_t stride() const noexcept { return stride_; }
+    TrajectoryEncoding encoding() const noexcept { return encoding_; }
+
+    // Decodes the next row; false once all rows were read
+    bool next(TrajectoryRecord& record);
+    void rewind();
+
+private:
+    const unsigned char* data_ = nullptr;
+    std::size_t size_ = 0;
+    std::size_t dimension_ = 0;
+    std::size_t rowCount_ = 0;
+    std::size_t rowBytes_ = 0;
+    std::size_t stride_ = 1;
+    TrajectoryEncoding encoding_ = TrajectoryEncoding::Float64;
+    std::size_t nextRow_ = 0;
+    Vector decoded_;
+};
+
+} // namespace gd
@@ -0,0 +1,69 @@
+#include "gd/autodiff.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+namespace gd {
+namespace ad {
+
+void Tape::reset() {
+    cursor_ = nullptr;
+    blockBegin_ = nullptr;
+    blockEnd_ = nullptr;
+    blockFirst_ = 0;
+    next_ = 0;
+    push(0, 0.0, 0, 0.0);   // the sink
+}
+
+void Tape::nextBlock() {
+    const std::size_t block = blockBegin_ == nullptr ? 0 : (blockFirst_ >> kBlockBits) + 1;
+    if (block == blocks_.size()) {
+        // Indices are 32-bit
+        if (capacity() + kBlockSize > std::numeric_limits<std::uint32_t>::max()) {
+            throw std::length_error("Autodiff tape exceeds 2^32 - 1 nodes");
+        }
+        blocks_.push_back(std::make_unique<Node[]>(kBlockSize));
+    }
+    blockBegin_ = blocks_[block].get();
+    blockEnd_ = blockBegin_ + kBlockSize;
+    blockFirst_ = block << kBlockBits;
+    cursor_ = blockBegin_;
+}
+
+void Tape::gradient(const Var& output, std::size_t count, double* gradient) {
+    if (count >= size()) {
+        throw std::invalid_argument("Autodiff gradient requested for more variables than recorded");
+    }
+    std::fill(gradient, gradient + count, 0.0);
+    if (output.isConstant()) {
+        return;
+    }
+
+    const std::size_t last = output.index();
+    adjoints_.assign(last + 1, 0.0);
+    adjoints_[last] = 1.0;
+    double* adjoints = adjoints_.data();
+
+    // Nodes only reference earlier nodes, so one backward pass suffices.
+    // Constant parents hit the sink (index 0) with a zero partial.
+    for (std::size_t block = last >> kBlockBits; block + 1 > 0; --block) {
+        const Node* nodes = blocks_[block].get();
+        const std::size_t first = block << kBlockBits;
+        for (std::size_t i = std::min(last, first + kBlockSize - 1) + 1; i-- > first;) {
+            const Node& node = nodes[i - first];
+            const double adjoint = adjoints[i];
+            adjoints[node.lhs] += adjoint * node.dLhs;
+            adjoints[node.rhs] += adjoint * node.dRhs;
+        }
+    }
+    std::copy(adjoints + 1, adjoints + 1 + std::min(count, last), gradient);
+}
+
+Tape& threadTape() {
+    thread_local Tape tape;
+    return tape;
+}
+
+} // namespace ad
+} // namespace gd
@@ -0,0 +1,226 @@
+#include "gd/checkpoint.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+namespace gd {
+namespace {
+
+constexpr char kMagic[8] = {'G', 'D', 'C', 'K', 'P', 'T', '\0', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+std::uint64_t fnv1a(const unsigned char* data, std::size_t size) {
+    std::uint64_t hash = 1469598103934665603ull;
+    for (std::size_t i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+template <class T>
+void put(std::vector<unsigned char>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void putDoubles(std::vector<unsigned char>& out, const std::vector<double>& values) {
+    put<std::uint64_t>(out, values.size());
+    const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+    out.insert(out.end(), bytes, bytes + values.size() * sizeof(double));
+}
+
+class Cursor {
+public:
+    Cursor(const std::vector<unsigned char>& data, std::size_t end, const std::string& path)
+        : data_(data), end_(end), path_(path) {}
+
+    template <class T>
+    T get() {
+        T value{};
+        take(&value, sizeof(T));
+        return value;
+    }
+
+    std::vector<double> getDoubles() {
+        const auto count = get<std::uint64_t>();
+        if (count > (end_ - offset_) / sizeof(double)) {
+            corrupt();
+        }
+        std::vector<double> values(static_cast<std::size_t>(count));
+        take(values.data(), values.size() * sizeof(double));
+        return values;
+    }
+
+    bool atEnd() const noexcept { return offset_ == end_; }
+
+    [[noreturn]] void corrupt() const {
+        throw std::runtime_error("Corrupt checkpoint file: " + path_);
+    }
+
+private:
+    void take(void* out, std::size_t size) {
+        if (size > end_ - offset_) {
+            corrupt();
+        }
+        std::memcpy(out, data_.data() + offset_, size);
+        offset_ += size;
+    }
+
+    const std::vector<unsigned char>& data_;
+    std::size_t end_;
+    std::size_t offset_ = 0;
+    const std::string& path_;
+};
+
+} // namespace
+
+// ------------------------- Checkpoint I/O -------------------------
+void saveCheckpoint(const std::string& path, const Checkpoint& checkpoint) {
+    std::vector<unsigned char> bytes;
+    bytes.reserve(128 + (checkpoint.parameters.size() + checkpoint.optimizerState.size()) * sizeof(double));
+    bytes.insert(bytes.end(), kMagic, kMagic + sizeof(kMagic));
+    put<std::uint32_t>(bytes, kVersion);
+    put<std::uint32_t>(bytes, 0); // reserved
+    put<std::uint64_t>(bytes, checkpoint.iteration);
+    put<double>(bytes, checkpoint.config.learningRate);
+    put<double>(bytes, checkpoint.config.tolerance);
+    put<std::uint64_t>(bytes, checkpoint.config.maxIterations);
+    put<double>(bytes, checkpoint.config.numericGradientStep);
+    putDoubles(bytes, checkpoint.parameters);
+    putDoubles(bytes, checkpoint.optimizerState);
+    put<std::uint64_t>(bytes, fnv1a(bytes.data(), bytes.size()));
+
+    const std::string tmpPath = path + ".tmp";
+    {
+        std::ofstream file(tmpPath, std::ios::out | std::ios::trunc | std::ios::binary);
+        if (!file) {
+            throw std::runtime_error("Failed to open checkpoint file: " + tmpPath);
+        }
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+        file.flush();
+        if (!file) {
+            throw std::runtime_error("Failed to write checkpoint file: " + tmpPath);
+        }
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        throw std::runtime_error("Failed to replace checkpoint file: " + path);
+    }
+}
+
+Checkpoint loadCheckpoint(const std::string& path) {
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open checkpoint file: " + path);
+    }
+    const std::vector<unsigned char> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+    constexpr std::size_t kChecksumBytes = sizeof(std::uint64_t);
+    if (bytes.size() < sizeof(kMagic) + kChecksumBytes ||
+        std::memcmp(bytes.data(), kMagic, sizeof(kMagic)) != 0) {
+        throw std::runtime_error("Not a checkpoint file: " + path);
+    }
+    const std::size_t payload = bytes.size() - kChecksumBytes;
+    std::uint64_t checksum = 0;
+    std::memcpy(&checksum, bytes.data() + payload, kChecksumBytes);
+    if (checksum != fnv1a(bytes.data(), payload)) {
+        throw std::runtime_error("Corrupt checkpoint file: " + path);
+    }
+
+    Cursor in(bytes, payload, path);
+    in.get<std::uint64_t>(); // magic
+    if (in.get<std::uint32_t>() != kVersion) {
+        throw std::runtime_error("Unsupported checkpoint version: " + path);
+    }
+    in.get<std::uint32_t>(); // reserved
+
+    Checkpoint checkpoint;
+    checkpoint.iteration = in.get<std::uint64_t>();
+    checkpoint.config.learningRate = in.get<double>();
+    checkpoint.config.tolerance = in.get<double>();
+    checkpoint.config.maxIterations = static_cast<std::size_t>(in.get<std::uint64_t>());
+    checkpoint.config.numericGradientStep = in.get<double>();
+    checkpoint.parameters = in.getDoubles();
+    checkpoint.optimizerState = in.getDoubles();
+    if (!in.atEnd()) {
+        in.corrupt();
+    }
+    return checkpoint;
+}
+
+// ------------------------- Checkpoint Callback -------------------------
+CheckpointCallback::CheckpointCallback(std::string path, std::size_t period)
+    : path_(std::move(path)), period_(period == 0 ? 1 : period) {
+    writer_ = std::thread([this] { writerLoop(); });
+}
+
+CheckpointCallback::~CheckpointCallback() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        closing_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
+}
+
+void CheckpointCallback::onIteration(TrainerState& state) {
+    if (state.iteration % period_ != 0) return;
+
+    auto snapshot = std::make_unique<Checkpoint>();
+    snapshot->iteration = state.iteration;
+    snapshot->parameters = state.parameters;
+    snapshot->config = state.config;
+    snapshot->optimizerState = state.optimizerState;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!error_.empty()) {
+            throw std::runtime_error(error_);
+        }
+        pending_ = std::move(snapshot);
+    }
+    wake_.notify_one();
+}
+
+void CheckpointCallback::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    idle_.wait(lock, [this] { return !pending_ && !writing_; });
+    if (!error_.empty()) {
+        throw std::runtime_error(error_);
+    }
+}
+
+void CheckpointCallback::writerLoop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        wake_.wait(lock, [this] { return pending_ || closing_; });
+        if (!pending_) {
+            return; // closing and nothing left to write
+        }
+        std::unique_ptr<Checkpoint> snapshot = std::move(pending_);
+        writing_ = true;
+        lock.unlock();
+
+        std::string error;
+        try {
+            saveCheckpoint(path_, *snapshot);
+        } catch (const std::exception& ex) {
+            error = ex.what();
+        }
+
+        lock.lock();
+        writing_ = false;
+        if (!error.empty() && error_.empty()) {
+            error_ = std::move(error);
+        }
+        if (!pending_) {
+            idle_.notify_all();
+        }
+    }
+}
+
+} // namespace gd
@@ -0,0 +1,133 @@
+#include "gd/convergence.hpp"
+#include "gd/kernels.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace gd {
+namespace {
+
+// True when `iteration` does not continue the run seen so far
+bool startsNewRun(std::size_t iteration, std::size_t& lastIteration) {
+    const bool fresh = lastIteration == std::numeric_limits<std::size_t>::max() || iteration <= lastIteration;
+    lastIteration = iteration;
+    return fresh;
+}
+
+} // namespace
+
+// ------------------------- Value Change -------------------------
+ValueChangeStop::ValueChangeStop(std::size_t window, double absoluteTolerance, double relativeTolerance)
+    : window_(window == 0 ? 1 : window),
+      absoluteTolerance_(absoluteTolerance),
+      relativeTolerance_(relativeTolerance),
+      history_(window_ + 1, 0.0) {
+    if (absoluteTolerance_ < 0.0 || relativeTolerance_ < 0.0) {
+        throw std::invalid_argument("Value change tolerances must be non-negative");
+    }
+}
+
+void ValueChangeStop::onIteration(TrainerState& state) {
+    if (startsNewRun(state.iteration, lastIteration_)) {
+        seen_ = 0;
+    }
+    history_[seen_ % history_.size()] = state.value;
+    ++seen_;
+    if (seen_ <= window_) return;
+
+    // The slot after the newest one holds the value from `window` iterations ago
+    const double old = history_[seen_ % history_.size()];
+    const double change = std::fabs(state.value - old);
+    if (absoluteTolerance_ > 0.0 && change <= absoluteTolerance_) {
+        state.requestStop(StopReason::AbsoluteValueChange);
+    } else if (relativeTolerance_ > 0.0 && change <= relativeTolerance_ * std::fabs(old)) {
+        state.requestStop(StopReason::RelativeValueChange);
+    }
+}
+
+// ------------------------- Step Size -------------------------
+StepSizeStop::StepSizeStop(double tolerance)
+    : tolerance_(tolerance) {}
+
+void StepSizeStop::onIteration(TrainerState& state) {
+    if (startsNewRun(state.iteration, lastIteration_)) {
+        havePrevious_ = false;
+    }
+    const Vector& x = state.parameters;
+    if (havePrevious_ && previous_.size() == x.size()) {
+        double sumSquares = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double d = x[i] - previous_[i];
+            sumSquares += d * d;
+        }
+        if (std::sqrt(sumSquares) < tolerance_) {
+            state.requestStop(StopReason::StepSize);
+        }
+    }
+    previous_.assign(x.begin(), x.end());
+    havePrevious_ = true;
+}
+
+// ------------------------- Gradient Norm -------------------------
+GradientNormStop::GradientNormStop(double tolerance)
+    : tolerance_(tolerance) {}
+
+void GradientNormStop::onIteration(TrainerState& state) {
+    double norm;
+    if (state.proximalPoint != nullptr) {
+        const Vector& x = state.parameters;
+        const Vector& p = *state.proximalPoint;
+        double sumSquares = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) {
+            const double d = x[i] - p[i];
+            sumSquares += d * d;
+        }
+        // An earlier callback may have changed config.learningRate since
+        norm = std::sqrt(sumSquares) / state.proximalLearningRate;
+    } else {
+        const Vector& grad = state.gradient;
+        ThreadPool* pool = grad.size() >= kParallelThreshold ? &defaultThreadPool() : nullptr;
+        norm = norm2(grad, pool);
+    }
+    if (norm < tolerance_) {
+        state.requestStop(StopReason::GradientNorm);
+    }
+}
+
+// ------------------------- Time Budget -------------------------
+TimeBudgetStop::TimeBudgetStop(double seconds)
+    : budget_(std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(seconds))) {}
+
+void TimeBudgetStop::onIteration(TrainerState& state) {
+    const auto now = Clock::now();
+    if (startsNewRun(state.iteration, lastIteration_)) {
+        start_ = now;
+    }
+    if (now - start_ >= budget_) {
+        state.requestStop(StopReason::TimeBudget);
+    }
+}
+
+// ------------------------- Evaluation Budget -------------------------
+EvaluationBudgetStop::EvaluationBudgetStop(std::size_t maxValueEvaluations, std::size_t maxGradientEvaluations)
+    : maxValueEvaluations_(maxValueEvaluations), maxGradientEvaluations_(maxGradientEvaluations) {}
+
+void EvaluationBudgetStop::onIteration(TrainerState& state) {
+    if (startsNewRun(state.iteration, lastIteration_)) {
+        lastValueEvaluations_ = 0;
+        lastGradientEvaluations_ = 0;
+    }
+    const std::size_t values = state.profile.valueEvaluations;
+    const std::size_t gradients = state.profile.gradientEvaluations;
+    const std::size_t nextValues = values + (values - lastValueEvaluations_);
+    const std::size_t nextGradients = gradients + (gradients - lastGradientEvaluations_);
+    lastValueEvaluations_ = values;
+    lastGradientEvaluations_ = gradients;
+
+    if ((maxValueEvaluations_ != 0 && nextValues > maxValueEvaluations_) ||
+        (maxGradientEvaluations_ != 0 && nextGradients > maxGradientEvaluations_)) {
+        state.requestStop(StopReason::EvaluationBudget);
+    }
+}
+
+} // namespace gd
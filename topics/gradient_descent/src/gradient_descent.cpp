@@ -1,12 +1,23 @@
 #include "gd/gradient_descent.hpp"
+#include "gd/checkpoint.hpp"
+#include "gd/kernels.hpp"
+#include "gd/proximal.hpp"
+#include "gd/spsc_queue.hpp"
 
 #include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
 #include <cmath>
+#include <condition_variable>
+#include <filesystem>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <thread>
 
 namespace gd {
 
@@ -59,6 +70,11 @@ Vector Objective::gradient(const Vector& x) const {
     return grad;
 }
 
+double Objective::valueAndGradient(const Vector& x, Vector& grad) const {
+    grad = gradient(x);
+    return value(x);
+}
+
 // ------------------------- Optimizer Config -------------------------
 void OptimConfig::applyDefaults() {
     if (!(learningRate > 0.0)) {
@@ -75,50 +91,224 @@ void OptimConfig::applyDefaults() {
     }
 }
 
+// ------------------------- Stop Reasons -------------------------
+std::string stopReasonToString(StopReason reason) {
+    switch (reason) {
+        case StopReason::MaxIterations:
+            return "max_iterations";
+        case StopReason::GradientTolerance:
+            return "gradient_tolerance";
+        case StopReason::Callback:
+            return "callback";
+        case StopReason::TargetValue:
+            return "target_value";
+        case StopReason::AbsoluteValueChange:
+            return "absolute_value_change";
+        case StopReason::RelativeValueChange:
+            return "relative_value_change";
+        case StopReason::StepSize:
+            return "step_size";
+        case StopReason::GradientNorm:
+            return "gradient_norm";
+        case StopReason::TimeBudget:
+            return "time_budget";
+        case StopReason::EvaluationBudget:
+            return "evaluation_budget";
+        case StopReason::Cancelled:
+        default:
+            return "cancelled";
+    }
+}
+
 // ------------------------- Optimizer Step -------------------------
 void GradientDescentOptimizer::step(const OptimConfig& config, Vector& x, const Vector& gradient) const {
-    for (std::size_t i = 0; i < x.size(); ++i) {
-        x[i] -= config.learningRate * gradient[i];
-    }
+    ThreadPool* pool = x.size() >= kParallelThreshold ? &defaultThreadPool() : nullptr;
+    axpy(-config.learningRate, gradient.data(), x.data(), x.size(), pool);
 }
 
 // ------------------------- CSV Logger -------------------------
-CsvLogger::CsvLogger(std::string path)
-    : path_(std::move(path)) {}
+namespace {
+
+// Upper bound for one shortest round-trip double or size_t plus separator
+constexpr std::size_t kMaxFieldChars = 32;
+
+// Resuming a CSV log: keeps `header` and the rows before `firstIteration`,
+// dropping later rows and a torn last line. False if there is no complete
+// header to continue after.
+bool keepRowsBefore(const std::string& path, const std::string& header, std::size_t firstIteration) {
+    std::ifstream in(path, std::ios::binary);
+    std::string line;
+    if (!in || !std::getline(in, line) || in.eof()) {
+        return false;
+    }
+    if (line + '\n' != header) {
+        throw std::runtime_error("Cannot append to CSV file with different columns: " + path);
+    }
+    std::uintmax_t keep = header.size();
+    while (std::getline(in, line) && !in.eof()) {
+        std::size_t iteration = 0;
+        const auto parsed = std::from_chars(line.data(), line.data() + line.size(), iteration);
+        if (parsed.ec != std::errc() || iteration >= firstIteration) break;
+        keep += line.size() + 1;
+    }
+    in.close();
+    std::filesystem::resize_file(path, keep);
+    return true;
+}
+
+} // namespace
+
+// Owns the file, a small ring of buffers and the writer thread. The training
+// thread fills the current buffer; full buffers travel to the writer through
+// `filled_` and come back empty through `free_`. The queues stay lock-free;
+// the mutex only guards sleeping, so each side takes it once per buffer (to
+// signal the other) and the idle writer blocks instead of polling.
+class CsvLogger::Writer {
+public:
+    Writer(const std::string& path, std::size_t bufferSize, bool append)
+        : file_(path, std::ios::out | (append ? std::ios::app : std::ios::trunc) | std::ios::binary),
+          filled_(kBufferCount),
+          free_(kBufferCount) {
+        if (!file_) {
+            throw std::runtime_error("Failed to open CSV file: " + path);
+        }
+        buffers_.resize(kBufferCount);
+        for (std::size_t i = 0; i < kBufferCount; ++i) {
+            buffers_[i].resize(bufferSize);
+            if (i != current_) free_.tryPush(i);
+        }
+        thread_ = std::thread([this] { run(); });
+    }
+
+    ~Writer() {
+        handOff(false);
+        closing_.store(true, std::memory_order_release);
+        signal(chunkReady_);
+        thread_.join();
+    }
+
+    // Returns room for at least `bytes` characters in the current buffer
+    char* reserve(std::size_t bytes) {
+        if (failed_.load(std::memory_order_relaxed)) {
+            throw std::runtime_error("Failed to write CSV file");
+        }
+        if (used_ + bytes > buffers_[current_].size()) {
+            handOff(true);
+            if (bytes > buffers_[current_].size()) {
+                buffers_[current_].resize(bytes);
+            }
+        }
+        return buffers_[current_].data() + used_;
+    }
+
+    void commit(const char* end) {
+        used_ = static_cast<std::size_t>(end - buffers_[current_].data());
+    }
+
+private:
+    static constexpr std::size_t kBufferCount = 4;
+
+    struct Chunk {
+        std::size_t buffer = 0;
+        std::size_t size = 0;
+    };
+
+    // Taking the mutex before notifying means a waiter that has just seen an
+    // empty queue is either already asleep or will re-check and see the item
+    void signal(std::condition_variable& condition) {
+        { const std::lock_guard<std::mutex> lock(mutex_); }
+        condition.notify_one();
+    }
+
+    // `filled_` holds every buffer, so the push never fails
+    void handOff(bool acquireNext) {
+        if (used_ == 0) return;
+        filled_.tryPush(Chunk{current_, used_});
+        used_ = 0;
+        signal(chunkReady_);
+        if (!acquireNext) return;
+        if (free_.tryPop(current_)) return;
+        std::unique_lock<std::mutex> lock(mutex_);
+        bufferFree_.wait(lock, [this] { return free_.tryPop(current_); });
+    }
+
+    void run() {
+        Chunk chunk;
+        while (true) {
+            // Read the flag first: once it is set every chunk is already queued
+            const bool closing = closing_.load(std::memory_order_acquire);
+            if (filled_.tryPop(chunk)) {
+                file_.write(buffers_[chunk.buffer].data(), static_cast<std::streamsize>(chunk.size));
+                if (!file_) failed_.store(true, std::memory_order_relaxed);
+                free_.tryPush(chunk.buffer);
+                signal(bufferFree_);
+                continue;
+            }
+            if (closing) break;
+            std::unique_lock<std::mutex> lock(mutex_);
+            chunkReady_.wait(lock, [this] {
+                return !filled_.empty() || closing_.load(std::memory_order_acquire);
+            });
+        }
+        file_.flush();
+    }
+
+    std::ofstream file_;
+    std::vector<std::vector<char>> buffers_;
+    std::size_t current_ = 0; // producer-owned buffer
+    std::size_t used_ = 0;
+    SpscQueue<Chunk> filled_;      // producer -> writer
+    SpscQueue<std::size_t> free_;  // writer -> producer
+    std::atomic<bool> closing_{false};
+    std::atomic<bool> failed_{false};
+    std::mutex mutex_;
+    std::condition_variable chunkReady_;   // producer -> idle writer
+    std::condition_variable bufferFree_;   // writer -> producer out of buffers
+    std::thread thread_;
+};
+
+CsvLogger::CsvLogger(std::string path, std::size_t stride, std::size_t bufferSize, bool append)
+    : path_(std::move(path)), stride_(stride == 0 ? 1 : stride), bufferSize_(bufferSize), append_(append) {}
 
 CsvLogger::~CsvLogger() = default;
 
-void CsvLogger::ensureStream() {
-    if (stream_) return;
+void CsvLogger::open(const TrainerState& state) {
+    std::string header = "iter,value,grad_norm_inf,lr";
+    for (std::size_t i = 0; i < state.parameters.size(); ++i) {
+        header += ",x" + std::to_string(i + 1);
+    }
+    header += '\n';
 
-    ownedStream_ = std::make_unique<std::ofstream>(path_, std::ios::out | std::ios::trunc);
-    auto* file = dynamic_cast<std::ofstream*>(ownedStream_.get());
-    if (!file || !*file) {
-        throw std::runtime_error("Failed to open CSV file: " + path_);
+    const bool continued = append_ && keepRowsBefore(path_, header, state.iteration);
+    writer_ = std::make_unique<Writer>(path_, bufferSize_, continued);
+    if (!continued) {
+        char* out = writer_->reserve(header.size());
+        writer_->commit(std::copy(header.begin(), header.end(), out));
     }
-    stream_ = ownedStream_.get();
 }
 
 void CsvLogger::onIteration(TrainerState& state) {
-    ensureStream();
-    if (!wroteHeader_) {
-        (*stream_) << "iter,value,grad_norm_inf,lr";
-        for (std::size_t i = 0; i < state.parameters.size(); ++i) {
-            (*stream_) << ",x" << i + 1;
-        }
-        (*stream_) << '\n';
-        wroteHeader_ = true;
+    if (state.iteration % stride_ != 0) return;
+    if (!writer_) {
+        open(state);
     }
 
-    (*stream_) << state.iteration << ','
-               << std::setprecision(17) << state.value << ','
-               << state.gradNormInf << ','
-               << state.config.learningRate;
+    const std::size_t bound = kMaxFieldChars * (4 + state.parameters.size()) + 1;
+    char* out = writer_->reserve(bound);
+    char* const last = out + bound;
+    out = std::to_chars(out, last, state.iteration).ptr;
+    *out++ = ',';
+    out = std::to_chars(out, last, state.value).ptr;
+    *out++ = ',';
+    out = std::to_chars(out, last, state.gradNormInf).ptr;
+    *out++ = ',';
+    out = std::to_chars(out, last, state.config.learningRate).ptr;
     for (double xi : state.parameters) {
-        (*stream_) << ',' << xi;
+        *out++ = ',';
+        out = std::to_chars(out, last, xi).ptr;
     }
-    (*stream_) << '\n';
-    stream_->flush();
+    *out++ = '\n';
+    writer_->commit(out);
 }
 
 // ------------------------- Console Logger -------------------------
@@ -155,63 +345,230 @@ EarlyStop::EarlyStop(double targetValue)
 
 void EarlyStop::onIteration(TrainerState& state) {
     if (state.value <= targetValue_) {
-        state.stop = true;
+        state.requestStop(StopReason::TargetValue);
     }
 }
 
+// ------------------------- Profiler Callback -------------------------
+ProfilerCallback::ProfilerCallback(std::ostream& out, std::size_t period)
+    : stream_(&out), period_(period == 0 ? 1 : period) {}
+
+void ProfilerCallback::onIteration(TrainerState& state) {
+    if ((state.iteration + 1) % period_ != 0) return;
+    (*stream_) << "profile after " << state.iteration + 1 << " iterations\n";
+    writeProfile(*stream_, state.profile);
+}
+
 // ------------------------- Trainer -------------------------
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// inf-norm of (x - p)
+double maxAbsDifference(const Vector& x, const Vector& p) {
+    double result = 0.0;
+    for (std::size_t i = 0; i < x.size(); ++i) {
+        const double d = std::fabs(x[i] - p[i]);
+        result = d > result ? d : result;
+    }
+    return result;
+}
+
+} // namespace
+
+Trainer::Trainer(std::shared_ptr<const ProximalOperator> proximal, bool accelerate)
+    : proximal_(std::move(proximal)), accelerate_(accelerate) {}
+
 TrainStats Trainer::minimize(Objective& objective,
                              Vector& x,
                              OptimConfig& config,
                              const std::vector<std::shared_ptr<Callback>>& callbacks) const {
+    return run(objective, x, config, callbacks, 0, Vector{});
+}
+
+TrainStats Trainer::resume(Objective& objective,
+                           const Checkpoint& checkpoint,
+                           Vector& x,
+                           OptimConfig& config,
+                           const std::vector<std::shared_ptr<Callback>>& callbacks) const {
+    x = checkpoint.parameters;
+    // The step size (possibly changed by callbacks) and the finite-difference
+    // step carry on from the checkpoint; how long to run is the caller's call
+    OptimConfig resumed = checkpoint.config;
+    resumed.maxIterations = config.maxIterations;
+    resumed.tolerance = config.tolerance;
+    config = resumed;
+    return run(objective, x, config, callbacks, static_cast<std::size_t>(checkpoint.iteration),
+               checkpoint.optimizerState);
+}
+
+TrainStats Trainer::run(Objective& objective,
+                        Vector& x,
+                        OptimConfig& config,
+                        const std::vector<std::shared_ptr<Callback>>& callbacks,
+                        std::size_t firstIteration,
+                        const Vector& optimizerState) const {
     // ✅ Do not call protected ensureDimension here. Check via public API.
     if (x.size() != objective.dimension()) {
         throw std::invalid_argument("Vector dimension mismatch");
     }
     config.applyDefaults();
-    objective.setFiniteDifferenceStep(config.numericGradientStep);
+    // Only write when needed so runs sharing an objective stay read-only.
+    if (objective.finiteDifferenceStep() != config.numericGradientStep) {
+        objective.setFiniteDifferenceStep(config.numericGradientStep);
+    }
+
+    const std::size_t dim = objective.dimension();
+    const bool composite = proximal_ != nullptr;
+    ThreadPool* pool = dim >= kParallelThreshold ? &defaultThreadPool() : nullptr;
+
+    // FISTA state: [t, previous proximal point...]
+    Vector momentum;
+    if (accelerate_ && optimizerState.empty()) {
+        momentum.resize(dim + 1);
+        momentum[0] = 1.0;
+        std::copy(x.begin(), x.end(), momentum.begin() + 1);
+    } else if (accelerate_ && optimizerState.size() == dim + 1) {
+        momentum = optimizerState;
+    } else if (!optimizerState.empty()) {
+        throw std::invalid_argument("Optimizer state does not match this trainer");
+    }
 
     GradientDescentOptimizer optimizer;
     TrainStats stats;
-    Vector grad(objective.dimension(), 0.0);
+    TrainProfile& profile = stats.profile;
+    Vector grad(dim, 0.0);
+    Vector proxPoint(dim, 0.0);
     bool stop = false;
-
-    for (std::size_t iter = 0; iter < config.maxIterations; ++iter) {
-        const double value = objective.value(x);
-        grad = objective.gradient(x);
-        const double gradNorm = infNorm(grad);
+    StopReason stopReason = StopReason::Callback;
+
+    // proxPoint <- prox_{lr*g}(x - lr * grad), remembering the lr it used
+    double proxLearningRate = 0.0;
+    auto proximalStep = [&] {
+        std::copy(x.begin(), x.end(), proxPoint.begin());
+        axpy(-config.learningRate, grad.data(), proxPoint.data(), dim, pool);
+        if (composite) {
+            proximal_->apply(proxPoint, config.learningRate);
+        }
+        proxLearningRate = config.learningRate;
+    };
+    // value() calls hidden inside a finite-difference gradient
+    const std::size_t probesPerGradient = objective.hasAnalyticGradient() ? 0 : 2 * objective.dimension();
+    const bool fused = objective.hasFusedGradient();
+#if GD_PROFILING
+    const auto runStart = Clock::now();
+#endif
+
+    for (std::size_t iter = firstIteration; iter < config.maxIterations; ++iter) {
+        double value;
+        if (fused) {
+            // One pass into the reused buffer; timed as the gradient phase
+            PhaseTimer timer(profile, Phase::Gradient);
+            value = objective.valueAndGradient(x, grad);
+        } else {
+            {
+                PhaseTimer timer(profile, Phase::Value);
+                value = objective.value(x);
+            }
+            PhaseTimer timer(profile, Phase::Gradient);
+            grad = objective.gradient(x);
+        }
+        profile.valueEvaluations += 1 + probesPerGradient;
+        profile.gradientEvaluations += 1;
+        double gradNorm;
+        bool proxCurrent = composite;
+        if (composite) {
+            PhaseTimer timer(profile, Phase::Step);
+            proximalStep();
+            gradNorm = maxAbsDifference(x, proxPoint) / config.learningRate;
+        } else {
+            gradNorm = infNorm(grad);
+        }
 
         stats.iterations = iter + 1;
         stats.finalValue = value;
         stats.finalGradNorm = gradNorm;
 
-        TrainerState state{iter, value, gradNorm, x, grad, objective, config, stop};
-        for (const auto& cb : callbacks) {
-            if (cb) cb->onIteration(state);
+        TrainerState state{iter, value, gradNorm, x, grad, objective, config, stop, stopReason, profile, momentum,
+                           composite ? &proxPoint : nullptr, proxLearningRate};
+        {
+            PhaseTimer timer(profile, Phase::Callbacks);
+            for (const auto& cb : callbacks) {
+                if (cb) cb->onIteration(state);
+            }
+        }
+        // The prox point from above is still the step unless a callback
+        // moved x, edited the gradient or changed the learning rate
+        if (state.iterateModified || config.learningRate != proxLearningRate) {
+            proxCurrent = false;
         }
 
         if (stop) {
             stats.stoppedEarly = true;
-            break;
+            stats.stopReason = stopReason;
+        } else if (gradNorm < config.tolerance) {
+            stats.converged = true;
+            stats.stopReason = StopReason::GradientTolerance;
         }
 
-        if (gradNorm < config.tolerance) {
-            stats.converged = true;
+        if (stop || stats.converged) {
+            if (composite) {
+                // Hand back the proximal point rather than the raw iterate
+                PhaseTimer timer(profile, Phase::Step);
+                if (!proxCurrent) proximalStep();
+                x.swap(proxPoint);
+            }
             break;
         }
 
-        optimizer.step(config, x, grad);
+        PhaseTimer timer(profile, Phase::Step);
+
+        if (!composite && !accelerate_) {
+            optimizer.step(config, x, grad);
+            continue;
+        }
+
+        if (!proxCurrent) proximalStep();
+        if (!accelerate_) {
+            x.swap(proxPoint);
+            continue;
+        }
+        // FISTA: x <- p + (t - 1) / t' * (p - pPrev). Momentum restarts when
+        // it points uphill, (x - p) . (p - pPrev) > 0 (O'Donoghue & Candes),
+        // which keeps the linear rate on strongly convex problems.
+        double& t = momentum[0];
+        double* previous = momentum.data() + 1;
+        double uphill = 0.0;
+        for (std::size_t i = 0; i < dim; ++i) {
+            uphill += (x[i] - proxPoint[i]) * (proxPoint[i] - previous[i]);
+        }
+        if (uphill > 0.0) {
+            t = 1.0;
+        }
+        const double tNext = 0.5 * (1.0 + std::sqrt(1.0 + 4.0 * t * t));
+        const double beta = (t - 1.0) / tNext;
+        for (std::size_t i = 0; i < dim; ++i) {
+            const double p = proxPoint[i];
+            x[i] = p + beta * (p - previous[i]);
+            previous[i] = p;
+        }
+        t = tNext;
+    }
+
+    if (accelerate_ && !stop && !stats.converged) {
+        // Ran out of iterations: return the last proximal point, not the extrapolation
+        std::copy(momentum.begin() + 1, momentum.end(), x.begin());
     }
 
+#if GD_PROFILING
+    profile.totalSeconds = std::chrono::duration<double>(Clock::now() - runStart).count();
+#endif
     return stats;
 }
 
 double Trainer::infNorm(const Vector& values) {
-    double norm = 0.0;
-    for (double v : values) {
-        norm = std::max(norm, std::fabs(v));
-    }
-    return norm;
+    ThreadPool* pool = values.size() >= kParallelThreshold ? &defaultThreadPool() : nullptr;
+    return normInf(values, pool);
 }
 
 } // namespace gd
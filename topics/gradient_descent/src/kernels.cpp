@@ -0,0 +1,245 @@
+#include "gd/kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace gd {
+namespace {
+
+constexpr std::size_t kLanes = 8;
+
+// ---- single-block kernels: kLanes independent accumulators, fixed combine order
+
+double dotBlock(const double* x, const double* y, std::size_t n) {
+    double acc[kLanes] = {};
+    std::size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (std::size_t k = 0; k < kLanes; ++k) {
+            acc[k] += x[i + k] * y[i + k];
+        }
+    }
+    double tail = 0.0;
+    for (; i < n; ++i) {
+        tail += x[i] * y[i];
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7])) + tail;
+}
+
+double sumSquaresBlock(const double* x, std::size_t n) {
+    return dotBlock(x, x, n);
+}
+
+double maxAbsBlock(const double* x, std::size_t n) {
+    double acc[kLanes] = {};
+    std::size_t i = 0;
+    for (; i + kLanes <= n; i += kLanes) {
+        for (std::size_t k = 0; k < kLanes; ++k) {
+            const double a = std::fabs(x[i + k]);
+            acc[k] = a > acc[k] ? a : acc[k];
+        }
+    }
+    double result = 0.0;
+    for (; i < n; ++i) {
+        const double a = std::fabs(x[i]);
+        result = a > result ? a : result;
+    }
+    for (double a : acc) {
+        result = a > result ? a : result;
+    }
+    return result;
+}
+
+void axpyBlock(double alpha, const double* x, double* y, std::size_t n) {
+    for (std::size_t i = 0; i < n; ++i) {
+        y[i] += alpha * x[i];
+    }
+}
+
+std::size_t blockCount(std::size_t n) {
+    return (n + kKernelBlock - 1) / kKernelBlock;
+}
+
+bool useParallel(std::size_t n, ThreadPool* pool) {
+    return pool != nullptr && pool->size() > 1 && n >= kParallelThreshold;
+}
+
+// Applies `block(first, count)` to every block and folds the partials in block
+// order with `combine`, serially or on the pool.
+template <class Block, class Combine>
+double reduceBlocks(std::size_t n, ThreadPool* pool, double init, Block block, Combine combine) {
+    if (n <= kKernelBlock) {
+        return combine(init, block(0, n));
+    }
+    const std::size_t blocks = blockCount(n);
+    if (!useParallel(n, pool)) {
+        double result = init;
+        for (std::size_t b = 0; b < blocks; ++b) {
+            const std::size_t first = b * kKernelBlock;
+            result = combine(result, block(first, std::min(kKernelBlock, n - first)));
+        }
+        return result;
+    }
+    std::vector<double> partials(blocks);
+    parallelForRanges(*pool, 0, blocks, 1, [&](std::size_t b0, std::size_t b1) {
+        for (std::size_t b = b0; b < b1; ++b) {
+            const std::size_t first = b * kKernelBlock;
+            partials[b] = block(first, std::min(kKernelBlock, n - first));
+        }
+    });
+    double result = init;
+    for (double partial : partials) {
+        result = combine(result, partial);
+    }
+    return result;
+}
+
+double add(double a, double b) { return a + b; }
+double maxOf(double a, double b) { return b > a ? b : a; }
+
+} // namespace
+
+// ------------------------- Vector Kernels -------------------------
+void axpy(double alpha, const double* x, double* y, std::size_t n, ThreadPool* pool) {
+    if (!useParallel(n, pool)) {
+        axpyBlock(alpha, x, y, n);
+        return;
+    }
+    parallelForRanges(*pool, 0, blockCount(n), 1, [&](std::size_t b0, std::size_t b1) {
+        const std::size_t first = b0 * kKernelBlock;
+        const std::size_t last = std::min(n, b1 * kKernelBlock);
+        axpyBlock(alpha, x + first, y + first, last - first);
+    });
+}
+
+double dot(const double* x, const double* y, std::size_t n, ThreadPool* pool) {
+    return reduceBlocks(n, pool, 0.0,
+                        [x, y](std::size_t first, std::size_t count) { return dotBlock(x + first, y + first, count); },
+                        add);
+}
+
+double norm2(const double* x, std::size_t n, ThreadPool* pool) {
+    return std::sqrt(reduceBlocks(n, pool, 0.0,
+                                  [x](std::size_t first, std::size_t count) { return sumSquaresBlock(x + first, count); },
+                                  add));
+}
+
+double normInf(const double* x, std::size_t n, ThreadPool* pool) {
+    return reduceBlocks(n, pool, 0.0,
+                        [x](std::size_t first, std::size_t count) { return maxAbsBlock(x + first, count); },
+                        maxOf);
+}
+
+void axpy(double alpha, const Vector& x, Vector& y, ThreadPool* pool) {
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Vector dimension mismatch");
+    }
+    axpy(alpha, x.data(), y.data(), x.size(), pool);
+}
+
+double dot(const Vector& x, const Vector& y, ThreadPool* pool) {
+    if (x.size() != y.size()) {
+        throw std::invalid_argument("Vector dimension mismatch");
+    }
+    return dot(x.data(), y.data(), x.size(), pool);
+}
+
+double norm2(const Vector& x, ThreadPool* pool) {
+    return norm2(x.data(), x.size(), pool);
+}
+
+double normInf(const Vector& x, ThreadPool* pool) {
+    return normInf(x.data(), x.size(), pool);
+}
+
+ThreadPool& defaultThreadPool() {
+    static ThreadPool pool;
+    return pool;
+}
+
+// ------------------------- Parallel For -------------------------
+namespace {
+
+// Shared by the caller and its helper tasks. Helpers may be dequeued after the
+// caller returned, hence shared ownership; `fn` is only touched for ranges
+// that were claimed, which all happens before the caller returns.
+struct ParallelForState {
+    std::size_t begin = 0;
+    std::size_t end = 0;
+    std::size_t grain = 1;
+    std::size_t ranges = 0;
+    const std::function<void(std::size_t, std::size_t)>* fn = nullptr;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    // Claims and runs ranges until none are left
+    void drain() {
+        while (true) {
+            const std::size_t r = next.fetch_add(1, std::memory_order_relaxed);
+            if (r >= ranges) return;
+            if (!failed.load(std::memory_order_relaxed)) {
+                const std::size_t first = begin + r * grain;
+                const std::size_t last = std::min(end, first + grain);
+                try {
+                    (*fn)(first, last);
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(errorMutex);
+                    if (!error) error = std::current_exception();
+                    failed.store(true, std::memory_order_relaxed);
+                }
+            }
+            done.fetch_add(1, std::memory_order_acq_rel);
+        }
+    }
+};
+
+} // namespace
+
+void parallelForRanges(ThreadPool& pool,
+                       std::size_t begin,
+                       std::size_t end,
+                       std::size_t grain,
+                       const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (end <= begin) return;
+    if (grain == 0) grain = 1;
+    const std::size_t ranges = (end - begin + grain - 1) / grain;
+    if (ranges == 1 || pool.size() <= 1) {
+        for (std::size_t first = begin; first < end; first += grain) {
+            fn(first, std::min(end, first + grain));
+        }
+        return;
+    }
+
+    auto state = std::make_shared<ParallelForState>();
+    state->begin = begin;
+    state->end = end;
+    state->grain = grain;
+    state->ranges = ranges;
+    state->fn = &fn;
+
+    const std::size_t helpers = std::min(pool.size(), ranges - 1);
+    for (std::size_t h = 0; h < helpers; ++h) {
+        pool.submit([state] { state->drain(); });
+    }
+    state->drain();
+
+    while (state->done.load(std::memory_order_acquire) < ranges) {
+        if (!pool.runPendingTask()) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (state->error) {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace gd
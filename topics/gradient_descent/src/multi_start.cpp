@@ -0,0 +1,120 @@
+#include "gd/multi_start.hpp"
+
+#include <atomic>
+#include <stdexcept>
+#include <utility>
+
+namespace gd {
+namespace {
+
+// Appended after the user callbacks of every run: publishes "target reached"
+// and stops the run as soon as any run has published it.
+class TargetWatch final : public Callback {
+public:
+    TargetWatch(std::atomic<bool>& reached, bool enabled, double targetValue, MultiStartRunResult& result)
+        : reached_(reached), enabled_(enabled), targetValue_(targetValue), result_(result) {}
+
+    void onIteration(TrainerState& state) override {
+        if (!enabled_) return;
+        if (state.value <= targetValue_) {
+            result_.reachedTarget = true;
+            reached_.store(true, std::memory_order_relaxed);
+            state.requestStop(StopReason::TargetValue);
+        } else if (reached_.load(std::memory_order_relaxed)) {
+            result_.cancelled = true;
+            state.requestStop(StopReason::Cancelled);
+        }
+    }
+
+private:
+    std::atomic<bool>& reached_;
+    bool enabled_;
+    double targetValue_;
+    MultiStartRunResult& result_;
+};
+
+} // namespace
+
+MultiStartRunner::MultiStartRunner(MultiStartOptions options)
+    : options_(options), pool_(options.threads) {}
+
+MultiStartStats MultiStartRunner::run(Objective& objective,
+                                      std::vector<MultiStartRun> runs,
+                                      const CallbackFactory& makeCallbacks) {
+    MultiStartStats stats;
+    if (runs.empty()) {
+        return stats;
+    }
+
+    for (auto& r : runs) {
+        if (r.start.size() != objective.dimension()) {
+            throw std::invalid_argument("Vector dimension mismatch");
+        }
+        r.config.applyDefaults();
+    }
+
+    // The objective is shared: its finite-difference step is set once here so
+    // that no run ever writes to it (Trainer::minimize skips the write when
+    // equal). That only works if every run asks for the same step.
+    const double step = runs.front().config.numericGradientStep;
+    for (const auto& r : runs) {
+        if (r.config.numericGradientStep != step) {
+            throw std::invalid_argument("Multi-start runs must share numericGradientStep");
+        }
+    }
+    objective.setFiniteDifferenceStep(step);
+
+    stats.runs.resize(runs.size());
+    std::atomic<bool> reached{false};
+    const bool stopAtTarget = options_.stopAtTarget;
+    const double targetValue = options_.targetValue;
+
+    for (std::size_t i = 0; i < runs.size(); ++i) {
+        pool_.submit([&, i] {
+            MultiStartRunResult& result = stats.runs[i];
+            if (stopAtTarget && reached.load(std::memory_order_relaxed)) {
+                result.cancelled = true;
+                return;
+            }
+            result.started = true;
+            result.parameters = std::move(runs[i].start);
+
+            std::vector<std::shared_ptr<Callback>> callbacks;
+            if (makeCallbacks) {
+                callbacks = makeCallbacks(i);
+            }
+            callbacks.push_back(std::make_shared<TargetWatch>(reached, stopAtTarget, targetValue, result));
+
+            Trainer trainer;
+            result.stats = trainer.minimize(objective, result.parameters, runs[i].config, callbacks);
+        });
+    }
+    pool_.wait();
+
+    double valueSum = 0.0;
+    for (std::size_t i = 0; i < stats.runs.size(); ++i) {
+        const MultiStartRunResult& result = stats.runs[i];
+        if (result.cancelled) ++stats.cancelledRuns;
+        if (!result.started) continue;
+
+        ++stats.startedRuns;
+        if (result.stats.converged) ++stats.convergedRuns;
+        if (result.reachedTarget) stats.targetReached = true;
+        stats.totalIterations += result.stats.iterations;
+        valueSum += result.stats.finalValue;
+        if (result.stats.finalValue > stats.worstFinalValue) {
+            stats.worstFinalValue = result.stats.finalValue;
+        }
+        if (result.stats.finalValue < stats.bestValue) {
+            stats.bestValue = result.stats.finalValue;
+            stats.bestRun = i;
+        }
+    }
+    if (stats.startedRuns > 0) {
+        stats.meanFinalValue = valueSum / static_cast<double>(stats.startedRuns);
+        stats.bestParameters = stats.runs[stats.bestRun].parameters;
+    }
+    return stats;
+}
+
+} // namespace gd
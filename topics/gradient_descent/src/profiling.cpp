@@ -0,0 +1,110 @@
+#include "gd/profiling.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <ostream>
+
+namespace gd {
+namespace {
+
+unsigned highestBit(std::uint64_t value) noexcept {
+    unsigned bit = 0;
+    while (value >>= 1) ++bit;
+    return bit;
+}
+
+#if GD_PROFILING
+void writePhase(std::ostream& out, const char* name, const PhaseProfile& phase) {
+    out << std::left << std::setw(10) << name << std::right
+        << std::setw(10) << phase.count()
+        << std::setw(12) << phase.totalSeconds()
+        << std::setw(12) << phase.meanSeconds()
+        << std::setw(12) << phase.p50Seconds()
+        << std::setw(12) << phase.p99Seconds()
+        << std::setw(12) << phase.maxSeconds()
+        << '\n';
+}
+#endif
+
+} // namespace
+
+// ------------------------- Phase Profile -------------------------
+std::size_t PhaseProfile::bucketOf(std::uint64_t nanoseconds) noexcept {
+    constexpr std::uint64_t kLinear = std::uint64_t{1} << kSubBits;
+    if (nanoseconds < kLinear) {
+        return static_cast<std::size_t>(nanoseconds);
+    }
+    const unsigned exponent = std::min(highestBit(nanoseconds), kMaxExponent);
+    const std::uint64_t sub = (nanoseconds >> (exponent - kSubBits)) & (kLinear - 1);
+    const std::size_t bucket = ((exponent - kSubBits + 1) << kSubBits) + static_cast<std::size_t>(sub);
+    return std::min(bucket, kBuckets - 1);
+}
+
+std::uint64_t PhaseProfile::bucketUpperEdge(std::size_t bucket) noexcept {
+    constexpr std::uint64_t kLinear = std::uint64_t{1} << kSubBits;
+    if (bucket < kLinear) {
+        return bucket + 1;
+    }
+    const unsigned exponent = static_cast<unsigned>(bucket >> kSubBits) + kSubBits - 1;
+    const std::uint64_t sub = bucket & (kLinear - 1);
+    return ((kLinear | sub) + 1) << (exponent - kSubBits);
+}
+
+void PhaseProfile::record(std::uint64_t nanoseconds) noexcept {
+    ++buckets_[bucketOf(nanoseconds)];
+    ++count_;
+    totalNanoseconds_ += nanoseconds;
+    maxNanoseconds_ = std::max(maxNanoseconds_, nanoseconds);
+}
+
+double PhaseProfile::meanSeconds() const noexcept {
+    return count_ == 0 ? 0.0 : totalSeconds() / static_cast<double>(count_);
+}
+
+double PhaseProfile::percentileSeconds(double q) const noexcept {
+    if (count_ == 0) return 0.0;
+    q = std::min(std::max(q, 0.0), 1.0);
+    const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(std::ceil(q * static_cast<double>(count_))));
+    std::uint64_t seen = 0;
+    for (std::size_t i = 0; i < kBuckets; ++i) {
+        seen += buckets_[i];
+        if (seen >= rank) {
+            // The top bucket's edge can exceed what was observed; never report more than max
+            return static_cast<double>(std::min(bucketUpperEdge(i), maxNanoseconds_)) * 1e-9;
+        }
+    }
+    return maxSeconds();
+}
+
+// ------------------------- Report -------------------------
+void writeProfile(std::ostream& out, const TrainProfile& profile) {
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << "evaluations: value=" << profile.valueEvaluations
+        << " gradient=" << profile.gradientEvaluations;
+#if GD_PROFILING
+    out << " total=" << std::setprecision(6) << profile.totalSeconds << "s\n";
+    out << std::left << std::setw(10) << "phase" << std::right
+        << std::setw(10) << "count"
+        << std::setw(12) << "total[s]"
+        << std::setw(12) << "mean[s]"
+        << std::setw(12) << "p50[s]"
+        << std::setw(12) << "p99[s]"
+        << std::setw(12) << "max[s]"
+        << '\n';
+    out << std::setprecision(3);
+    writePhase(out, "value", profile.value);
+    writePhase(out, "gradient", profile.gradient);
+    writePhase(out, "callbacks", profile.callbacks);
+    writePhase(out, "step", profile.step);
+#else
+    out << "\n(timers compiled out: configure with -DGD_PROFILING=ON)\n";
+#endif
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+} // namespace gd
@@ -0,0 +1,135 @@
+#include "gd/proximal.hpp"
+#include "gd/kernels.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <utility>
+
+namespace gd {
+namespace {
+
+// Runs an element-wise update over [0, n), on the default pool for large n
+void forEachRange(std::size_t n, const std::function<void(std::size_t, std::size_t)>& fn) {
+    if (n < kParallelThreshold) {
+        fn(0, n);
+        return;
+    }
+    parallelForRanges(defaultThreadPool(), 0, n, kKernelBlock, fn);
+}
+
+} // namespace
+
+// ------------------------- Box -------------------------
+BoxProjection::BoxProjection(double lower, double upper)
+    : BoxProjection(Vector{lower}, Vector{upper}) {}
+
+BoxProjection::BoxProjection(Vector lower, Vector upper)
+    : lower_(std::move(lower)), upper_(std::move(upper)) {
+    if (lower_.empty() || lower_.size() != upper_.size()) {
+        throw std::invalid_argument("Box bounds must be non-empty and of equal size");
+    }
+    for (std::size_t i = 0; i < lower_.size(); ++i) {
+        if (!(lower_[i] <= upper_[i])) {
+            throw std::invalid_argument("Box lower bound exceeds upper bound");
+        }
+    }
+}
+
+void BoxProjection::apply(Vector& x, double step) const {
+    (void)step;
+    double* data = x.data();
+    if (lower_.size() == 1) {
+        const double lo = lower_[0];
+        const double hi = upper_[0];
+        forEachRange(x.size(), [=](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                data[i] = std::min(std::max(data[i], lo), hi);
+            }
+        });
+        return;
+    }
+    if (x.size() != lower_.size()) {
+        throw std::invalid_argument("Vector dimension mismatch");
+    }
+    const double* lo = lower_.data();
+    const double* hi = upper_.data();
+    forEachRange(x.size(), [=](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            data[i] = std::min(std::max(data[i], lo[i]), hi[i]);
+        }
+    });
+}
+
+// ------------------------- Simplex -------------------------
+SimplexProjection::SimplexProjection(double radius)
+    : radius_(radius) {
+    if (!(radius_ > 0.0)) {
+        throw std::invalid_argument("Simplex radius must be positive");
+    }
+}
+
+void SimplexProjection::apply(Vector& x, double step) const {
+    (void)step;
+    if (x.empty()) return;
+    // Sort-based projection: find the threshold theta such that
+    // sum(max(x - theta, 0)) == radius, then clip.
+    Vector sorted = x;
+    std::sort(sorted.begin(), sorted.end(), std::greater<double>());
+    double prefix = 0.0;
+    double theta = 0.0;
+    for (std::size_t j = 0; j < sorted.size(); ++j) {
+        prefix += sorted[j];
+        const double candidate = (prefix - radius_) / static_cast<double>(j + 1);
+        if (sorted[j] - candidate > 0.0) {
+            theta = candidate;
+        }
+    }
+    for (double& value : x) {
+        value = std::max(value - theta, 0.0);
+    }
+}
+
+// ------------------------- L1 -------------------------
+L1Proximal::L1Proximal(double lambda)
+    : lambda_(lambda) {
+    if (!(lambda_ >= 0.0)) {
+        throw std::invalid_argument("L1 weight must be non-negative");
+    }
+}
+
+void L1Proximal::apply(Vector& x, double step) const {
+    const double threshold = step * lambda_;
+    double* data = x.data();
+    forEachRange(x.size(), [=](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            const double shrunk = std::fabs(data[i]) - threshold;
+            data[i] = shrunk > 0.0 ? std::copysign(shrunk, data[i]) : 0.0;
+        }
+    });
+}
+
+// ------------------------- L2 Ball -------------------------
+L2BallProjection::L2BallProjection(double radius)
+    : radius_(radius) {
+    if (!(radius_ >= 0.0)) {
+        throw std::invalid_argument("L2 ball radius must be non-negative");
+    }
+}
+
+void L2BallProjection::apply(Vector& x, double step) const {
+    (void)step;
+    ThreadPool* pool = x.size() >= kParallelThreshold ? &defaultThreadPool() : nullptr;
+    const double norm = norm2(x, pool);
+    if (norm <= radius_) return;
+    const double scale = radius_ / norm;
+    double* data = x.data();
+    forEachRange(x.size(), [=](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            data[i] *= scale;
+        }
+    });
+}
+
+} // namespace gd
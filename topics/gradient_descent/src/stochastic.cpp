@@ -0,0 +1,361 @@
+#include "gd/stochastic.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gd {
+namespace {
+
+constexpr char kSampleMagic[8] = {'G', 'D', 'S', 'A', 'M', 'P', 'L', '\0'};
+constexpr std::size_t kSampleHeaderBytes = 32;
+
+// Rows per chunk when sweeping the full sample set
+constexpr std::size_t kFullPassChunk = 4096;
+
+// Rows [first, first + indices.size()) of the set, clipped at the end
+SampleBatch contiguousBatch(const SampleSet& samples, std::size_t first, std::vector<std::size_t>& indices) {
+    SampleBatch batch;
+    batch.count = std::min(indices.size(), samples.sampleCount() - first);
+    batch.width = samples.width();
+    batch.rows = samples.sample(first);
+    std::iota(indices.begin(), indices.begin() + static_cast<std::ptrdiff_t>(batch.count), first);
+    batch.indices = indices.data();
+    return batch;
+}
+
+// Hands out the batches of one epoch. With `shuffle` the rows of each batch
+// are gathered into a private buffer; otherwise batches point straight into
+// the sample set. With `prefetch` the next batch is gathered (or its pages
+// touched) on a background thread while the current one is in use.
+class BatchLoader {
+public:
+    BatchLoader(const SampleSet& samples, const StochasticConfig& config)
+        : samples_(samples),
+          batchSize_(config.batchSize),
+          shuffle_(config.shuffle),
+          rng_(config.seed),
+          order_(samples.sampleCount()) {
+        std::iota(order_.begin(), order_.end(), std::size_t{0});
+        if (shuffle_) {
+            for (auto& buffer : buffers_) {
+                buffer.resize(batchSize_ * samples_.width());
+            }
+        }
+        if (config.prefetch) {
+            prefetcher_ = std::make_unique<ThreadPool>(1);
+        }
+    }
+
+    void startEpoch() {
+        if (prefetcher_) prefetcher_->wait();
+        if (shuffle_) {
+            std::shuffle(order_.begin(), order_.end(), rng_);
+        }
+        position_ = 0;
+        schedule(0);
+    }
+
+    bool next(SampleBatch& batch) {
+        if (position_ >= order_.size()) return false;
+
+        const std::size_t count = std::min(batchSize_, order_.size() - position_);
+        const std::size_t slot = slot_;
+        if (prefetcher_) {
+            prefetcher_->wait();
+        } else {
+            load(slot, position_, count);
+        }
+
+        batch.indices = order_.data() + position_;
+        batch.count = count;
+        batch.width = samples_.width();
+        batch.rows = shuffle_ ? buffers_[slot].data() : samples_.sample(position_);
+
+        position_ += count;
+        slot_ = 1 - slot;
+        schedule(slot_);
+        return true;
+    }
+
+private:
+    void schedule(std::size_t slot) {
+        if (!prefetcher_ || position_ >= order_.size()) return;
+        const std::size_t first = position_;
+        const std::size_t count = std::min(batchSize_, order_.size() - first);
+        slot_ = slot;
+        prefetcher_->submit([this, slot, first, count] { load(slot, first, count); });
+    }
+
+    void load(std::size_t slot, std::size_t first, std::size_t count) {
+        const std::size_t width = samples_.width();
+        if (shuffle_) {
+            double* out = buffers_[slot].data();
+            for (std::size_t k = 0; k < count; ++k) {
+                std::memcpy(out + k * width, samples_.sample(order_[first + k]), width * sizeof(double));
+            }
+            return;
+        }
+        // Contiguous batch: fault its pages in ahead of use
+        const auto* bytes = reinterpret_cast<const volatile unsigned char*>(samples_.sample(first));
+        const std::size_t length = count * width * sizeof(double);
+        for (std::size_t offset = 0; offset < length; offset += 4096) {
+            (void)bytes[offset];
+        }
+    }
+
+    const SampleSet& samples_;
+    std::size_t batchSize_;
+    bool shuffle_;
+    std::mt19937_64 rng_;
+    std::vector<std::size_t> order_;
+    std::vector<double> buffers_[2];
+    std::size_t slot_ = 0;
+    std::size_t position_ = 0;
+    std::unique_ptr<ThreadPool> prefetcher_;
+};
+
+} // namespace
+
+// ------------------------- Sample Sets -------------------------
+InMemorySamples::InMemorySamples(std::vector<double> data, std::size_t width)
+    : data_(std::move(data)), width_(width), count_(0) {
+    if (width_ == 0 || data_.size() % width_ != 0) {
+        throw std::invalid_argument("Sample data size must be a multiple of the width");
+    }
+    count_ = data_.size() / width_;
+}
+
+MappedSamples::MappedSamples(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open sample file: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < kSampleHeaderBytes) {
+        ::close(fd);
+        throw std::runtime_error("Not a sample file: " + path);
+    }
+    mappingSize_ = static_cast<std::size_t>(info.st_size);
+    mapping_ = ::mmap(nullptr, mappingSize_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping_ == MAP_FAILED) {
+        mapping_ = nullptr;
+        throw std::runtime_error("Failed to map sample file: " + path);
+    }
+
+    const auto* bytes = static_cast<const unsigned char*>(mapping_);
+    std::uint64_t count = 0;
+    std::uint64_t width = 0;
+    std::memcpy(&count, bytes + 8, sizeof(count));
+    std::memcpy(&width, bytes + 16, sizeof(width));
+    const bool valid = std::memcmp(bytes, kSampleMagic, sizeof(kSampleMagic)) == 0 && width > 0 &&
+                       (mappingSize_ - kSampleHeaderBytes) / sizeof(double) / width >= count;
+    if (!valid) {
+        ::munmap(mapping_, mappingSize_);
+        mapping_ = nullptr;
+        throw std::runtime_error("Not a sample file: " + path);
+    }
+    count_ = static_cast<std::size_t>(count);
+    width_ = static_cast<std::size_t>(width);
+    data_ = reinterpret_cast<const double*>(bytes + kSampleHeaderBytes);
+}
+
+MappedSamples::~MappedSamples() {
+    if (mapping_) {
+        ::munmap(mapping_, mappingSize_);
+    }
+}
+
+void writeSampleFile(const std::string& path, const SampleSet& samples) {
+    std::ofstream file(path, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file) {
+        throw std::runtime_error("Failed to open sample file: " + path);
+    }
+    unsigned char header[kSampleHeaderBytes] = {};
+    const std::uint64_t count = samples.sampleCount();
+    const std::uint64_t width = samples.width();
+    std::memcpy(header, kSampleMagic, sizeof(kSampleMagic));
+    std::memcpy(header + 8, &count, sizeof(count));
+    std::memcpy(header + 16, &width, sizeof(width));
+    file.write(reinterpret_cast<const char*>(header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(samples.data()),
+               static_cast<std::streamsize>(count * width * sizeof(double)));
+    if (!file) {
+        throw std::runtime_error("Failed to write sample file: " + path);
+    }
+}
+
+// ------------------------- Finite-sum Objective -------------------------
+FiniteSumObjective::FiniteSumObjective(std::size_t dimension, const SampleSet& samples)
+    : Objective(dimension), samples_(&samples) {
+    if (samples.sampleCount() == 0) {
+        throw std::invalid_argument("Finite-sum objective needs at least one sample");
+    }
+}
+
+double FiniteSumObjective::value(const Vector& x) const {
+    ensureDimension(x);
+    const std::size_t n = samples_->sampleCount();
+    std::vector<std::size_t> indices(std::min(kFullPassChunk, n));
+    double sum = 0.0;
+    for (std::size_t first = 0; first < n; first += kFullPassChunk) {
+        const SampleBatch batch = contiguousBatch(*samples_, first, indices);
+        sum += valueOnBatch(x, batch) * static_cast<double>(batch.count);
+    }
+    return sum / static_cast<double>(n);
+}
+
+Vector FiniteSumObjective::analyticGradient(const Vector& x) const {
+    ensureDimension(x);
+    const std::size_t n = samples_->sampleCount();
+    Vector total(dimension(), 0.0);
+    Vector chunk(dimension(), 0.0);
+    std::vector<std::size_t> indices(std::min(kFullPassChunk, n));
+    for (std::size_t first = 0; first < n; first += kFullPassChunk) {
+        const SampleBatch batch = contiguousBatch(*samples_, first, indices);
+        gradientOnBatch(x, batch, chunk);
+        const double weight = static_cast<double>(batch.count);
+        for (std::size_t i = 0; i < total.size(); ++i) {
+            total[i] += weight * chunk[i];
+        }
+    }
+    for (double& g : total) {
+        g /= static_cast<double>(n);
+    }
+    return total;
+}
+
+// ------------------------- Stochastic Config -------------------------
+void StochasticConfig::applyDefaults() {
+    if (batchSize == 0) {
+        batchSize = 64;
+    }
+    if (epochs == 0) {
+        epochs = 10;
+    }
+}
+
+// ------------------------- Mini-batch Trainer -------------------------
+TrainStats StochasticTrainer::minimize(FiniteSumObjective& objective,
+                                       Vector& x,
+                                       OptimConfig& config,
+                                       StochasticConfig stochastic,
+                                       const std::vector<std::shared_ptr<Callback>>& callbacks) const {
+    if (x.size() != objective.dimension()) {
+        throw std::invalid_argument("Vector dimension mismatch");
+    }
+    config.applyDefaults();
+    stochastic.applyDefaults();
+
+    const std::size_t dim = objective.dimension();
+    GradientDescentOptimizer optimizer;
+    TrainStats stats;
+    TrainProfile& profile = stats.profile;
+    BatchLoader loader(objective.samples(), stochastic);
+
+    Vector grad(dim, 0.0);
+    const Vector noOptimizerState; // SVRG anchors are not checkpointed
+    Vector snapshot;             // SVRG anchor point
+    Vector snapshotGrad;         // full gradient at the anchor
+    Vector anchorBatchGrad(dim, 0.0);
+    bool stop = false;
+    StopReason stopReason = StopReason::Callback;
+    std::size_t step = 0;
+#if GD_PROFILING
+    const auto runStart = std::chrono::steady_clock::now();
+#endif
+
+    for (std::size_t epoch = 0; epoch < stochastic.epochs && !stop; ++epoch) {
+        if (stochastic.svrg || stochastic.evaluateEachEpoch) {
+            double fullValue;
+            Vector fullGrad;
+            {
+                PhaseTimer timer(profile, Phase::Value);
+                fullValue = objective.value(x);
+            }
+            {
+                PhaseTimer timer(profile, Phase::Gradient);
+                fullGrad = objective.gradient(x);
+            }
+            profile.valueEvaluations += 1;
+            profile.gradientEvaluations += 1;
+            stats.finalValue = fullValue;
+            stats.finalGradNorm = Trainer::infNorm(fullGrad);
+            if (stats.finalGradNorm < config.tolerance) {
+                stats.converged = true;
+                stats.stopReason = StopReason::GradientTolerance;
+                break;
+            }
+            if (stochastic.svrg) {
+                snapshot = x;
+                snapshotGrad = std::move(fullGrad);
+            }
+        }
+
+        loader.startEpoch();
+        SampleBatch batch;
+        while (loader.next(batch)) {
+            double value;
+            {
+                PhaseTimer timer(profile, Phase::Value);
+                value = objective.valueOnBatch(x, batch);
+            }
+            {
+                PhaseTimer timer(profile, Phase::Gradient);
+                objective.gradientOnBatch(x, batch, grad);
+                if (stochastic.svrg) {
+                    // g = grad_B(x) - grad_B(anchor) + full_grad(anchor)
+                    objective.gradientOnBatch(snapshot, batch, anchorBatchGrad);
+                    for (std::size_t i = 0; i < dim; ++i) {
+                        grad[i] += snapshotGrad[i] - anchorBatchGrad[i];
+                    }
+                }
+            }
+            profile.valueEvaluations += 1;
+            profile.gradientEvaluations += stochastic.svrg ? 2 : 1;
+            const double gradNorm = Trainer::infNorm(grad);
+
+            stats.iterations = step + 1;
+            stats.finalValue = value;
+            stats.finalGradNorm = gradNorm;
+
+            TrainerState state{step, value, gradNorm, x, grad, objective, config, stop, stopReason, profile, noOptimizerState};
+            {
+                PhaseTimer timer(profile, Phase::Callbacks);
+                for (const auto& cb : callbacks) {
+                    if (cb) cb->onIteration(state);
+                }
+            }
+            if (stop) {
+                stats.stoppedEarly = true;
+                stats.stopReason = stopReason;
+                break;
+            }
+
+            {
+                PhaseTimer timer(profile, Phase::Step);
+                optimizer.step(config, x, grad);
+            }
+            ++step;
+        }
+    }
+
+#if GD_PROFILING
+    profile.totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - runStart).count();
+#endif
+    return stats;
+}
+
+} // namespace gd
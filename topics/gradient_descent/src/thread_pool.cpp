@@ -0,0 +1,166 @@
+#include "gd/thread_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+namespace gd {
+namespace {
+
+// Identifies the pool/worker the current thread belongs to, so nested submits
+// land on the submitting worker's own deque.
+thread_local const ThreadPool* tlsPool = nullptr;
+thread_local std::size_t tlsIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(std::size_t threadCount) {
+    if (threadCount == 0) {
+        threadCount = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+    }
+    queues_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        queues_.push_back(std::make_unique<WorkerQueue>());
+    }
+    threads_.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        shuttingDown_ = true;
+    }
+    workAvailable_.notify_all();
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+}
+
+void ThreadPool::submit(Task task) {
+    std::size_t index;
+    if (tlsPool == this) {
+        index = tlsIndex;
+    } else {
+        index = nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    }
+
+    {
+        // Push and count under the state lock so a thief can never decrement
+        // queued_ before the matching increment.
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        {
+            std::lock_guard<std::mutex> queueLock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(task));
+        }
+        ++queued_;
+        ++pending_;
+    }
+    workAvailable_.notify_one();
+}
+
+bool ThreadPool::tryPop(std::size_t index, Task& task) {
+    WorkerQueue& queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::trySteal(std::size_t index, Task& task) {
+    const std::size_t count = queues_.size();
+    for (std::size_t offset = 1; offset <= count; ++offset) {
+        WorkerQueue& victim = *queues_[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        return true;
+    }
+    return false;
+}
+
+bool ThreadPool::tryAcquire(std::size_t index, Task& task) {
+    if (!tryPop(index, task) && !trySteal(index, task)) {
+        return false;
+    }
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    --queued_;
+    return true;
+}
+
+void ThreadPool::runTask(Task& task) {
+    try {
+        task();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (!firstError_) {
+            firstError_ = std::current_exception();
+        }
+    }
+    task = nullptr;
+
+    bool idle = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        idle = (--pending_ == 0);
+    }
+    if (idle) {
+        allDone_.notify_all();
+    }
+}
+
+void ThreadPool::workerLoop(std::size_t index) {
+    tlsPool = this;
+    tlsIndex = index;
+
+    Task task;
+    while (true) {
+        if (tryAcquire(index, task)) {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        workAvailable_.wait(lock, [this] { return shuttingDown_ || queued_ > 0; });
+        if (shuttingDown_ && queued_ == 0) {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::runPendingTask() {
+    const std::size_t index = (tlsPool == this) ? tlsIndex : 0;
+    Task task;
+    if (!tryAcquire(index, task)) {
+        return false;
+    }
+    runTask(task);
+    return true;
+}
+
+void ThreadPool::wait() {
+    // External callers steal starting from queue 0; workers start from their own.
+    const std::size_t index = (tlsPool == this) ? tlsIndex : 0;
+
+    Task task;
+    while (true) {
+        if (tryAcquire(index, task)) {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(stateMutex_);
+        allDone_.wait(lock, [this] { return pending_ == 0 || queued_ > 0; });
+        if (pending_ == 0) {
+            std::exception_ptr error = std::exchange(firstError_, nullptr);
+            lock.unlock();
+            if (error) {
+                std::rethrow_exception(error);
+            }
+            return;
+        }
+    }
+}
+
+} // namespace gd
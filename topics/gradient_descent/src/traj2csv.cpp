@@ -0,0 +1,123 @@
+#include "gd/trajectory.hpp"
+
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Args {
+    std::string inputPath;
+    std::string outputPath;
+    std::size_t every{1};
+    std::size_t maxRows{0};
+};
+
+void usage(const char *prog) {
+    std::cerr << "Usage: " << prog << " --input <trajectory> --output <csv> [--every <k>] [--max-rows <n>]\n";
+    std::cerr << "Converts a binary gd trajectory into the CSV read by the plotting scripts.\n";
+    std::cerr << "  --every k     keep every k-th stored row\n";
+    std::cerr << "  --max-rows n  decimate uniformly to at most n rows (n < 2 counts as 2)\n";
+    std::cerr << "The first and last stored rows are always kept." << std::endl;
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--help") || (arg == "-h")) {
+            return false;
+        } else if (arg == "--input" && i + 1 < argc) {
+            args.inputPath = argv[++i];
+        } else if (arg == "--output" && i + 1 < argc) {
+            args.outputPath = argv[++i];
+        } else if (arg == "--every" && i + 1 < argc) {
+            args.every = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--max-rows" && i + 1 < argc) {
+            args.maxRows = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            return false;
+        }
+    }
+    return !args.inputPath.empty() && !args.outputPath.empty();
+}
+
+// Rows written from `rows` stored rows when keeping every `step`-th one plus the last
+std::size_t keptRows(std::size_t rows, std::size_t step) {
+    if (rows == 0) return 0;
+    return (rows - 1) / step + 1 + ((rows - 1) % step != 0 ? 1 : 0);
+}
+
+char *appendDouble(char *out, char *last, double value) {
+    *out++ = ',';
+    return std::to_chars(out, last, value).ptr;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Args args;
+    if (!parseArgs(argc, argv, args)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    try {
+        gd::TrajectoryReader reader(args.inputPath);
+
+        std::size_t step = args.every == 0 ? 1 : args.every;
+        if (args.maxRows > 0 && keptRows(reader.rowCount(), step) > args.maxRows) {
+            // step = ceil((rows - 1) / (n - 1)): at most n - 1 strides fit, and when
+            // they miss the last row they number at most n - 2, so the last makes n
+            const std::size_t maxRows = args.maxRows < 2 ? 2 : args.maxRows;
+            step = (reader.rowCount() - 1 + maxRows - 2) / (maxRows - 1);
+        }
+
+        std::FILE *out = std::fopen(args.outputPath.c_str(), "wb");
+        if (!out) {
+            throw std::runtime_error("Failed to open CSV file: " + args.outputPath);
+        }
+
+        std::string header = "iter,value,grad_norm_inf,lr";
+        for (std::size_t i = 0; i < reader.dimension(); ++i) {
+            header += ",x" + std::to_string(i + 1);
+        }
+        header += '\n';
+        std::fputs(header.c_str(), out);
+
+        std::vector<char> line(32 * (4 + reader.dimension()) + 1);
+        char *const last = line.data() + line.size();
+        gd::TrajectoryRecord record;
+        std::size_t written = 0;
+        // Rows are decoded sequentially (delta encoding needs every row)
+        for (std::size_t row = 0; reader.next(record); ++row) {
+            if (row % step != 0 && row + 1 != reader.rowCount()) continue;
+            char *p = std::to_chars(line.data(), last, record.iteration).ptr;
+            p = appendDouble(p, last, record.value);
+            p = appendDouble(p, last, record.gradNormInf);
+            p = appendDouble(p, last, record.learningRate);
+            for (double xi : record.parameters) {
+                p = appendDouble(p, last, xi);
+            }
+            *p++ = '\n';
+            std::fwrite(line.data(), 1, static_cast<std::size_t>(p - line.data()), out);
+            ++written;
+        }
+
+        if (std::fclose(out) != 0) {
+            throw std::runtime_error("Failed to write CSV file: " + args.outputPath);
+        }
+        std::cerr << "Wrote " << written << " of " << reader.rowCount() << " rows to " << args.outputPath << std::endl;
+
+    } catch (const std::exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
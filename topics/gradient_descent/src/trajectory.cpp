@@ -0,0 +1,253 @@
+#include "gd/trajectory.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <stdexcept>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace gd {
+namespace {
+
+constexpr char kMagic[8] = {'G', 'D', 'T', 'R', 'A', 'J', '\0', '\0'};
+constexpr std::uint32_t kVersion = 1;
+
+std::size_t scalarBytes(TrajectoryEncoding encoding) {
+    return encoding == TrajectoryEncoding::Float64 ? sizeof(double) : sizeof(float);
+}
+
+std::size_t rowBytesFor(TrajectoryEncoding encoding, std::size_t dimension) {
+    return sizeof(std::uint64_t) + (3 + dimension) * scalarBytes(encoding);
+}
+
+template <class T>
+char* put(char* out, T value) {
+    std::memcpy(out, &value, sizeof(T));
+    return out + sizeof(T);
+}
+
+template <class T>
+const unsigned char* get(const unsigned char* in, T& value) {
+    std::memcpy(&value, in, sizeof(T));
+    return in + sizeof(T);
+}
+
+const unsigned char* getScalar(const unsigned char* in, TrajectoryEncoding encoding, double& value) {
+    if (encoding == TrajectoryEncoding::Float64) {
+        return get(in, value);
+    }
+    float narrow = 0.0f;
+    in = get(in, narrow);
+    value = narrow;
+    return in;
+}
+
+} // namespace
+
+// ------------------------- Trajectory Logger -------------------------
+TrajectoryLogger::TrajectoryLogger(std::string path,
+                                   TrajectoryEncoding encoding,
+                                   std::size_t stride,
+                                   std::size_t bufferSize,
+                                   bool append)
+    : path_(std::move(path)),
+      encoding_(encoding),
+      stride_(stride == 0 ? 1 : stride),
+      bufferSize_(bufferSize),
+      append_(append) {}
+
+TrajectoryLogger::~TrajectoryLogger() {
+    // No throwing from the destructor: a failed tail write just truncates rows
+    if (file_.is_open() && used_ > 0) {
+        file_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+    }
+}
+
+void TrajectoryLogger::open(std::size_t dimension, std::uint64_t firstIteration) {
+    dimension_ = dimension;
+    rowBytes_ = rowBytesFor(encoding_, dimension);
+    buffer_.resize(std::max(bufferSize_, rowBytes_));
+    decoded_.assign(dimension, 0.0);
+    if (append_ && reopen(firstIteration)) {
+        return;
+    }
+
+    file_.open(path_, std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!file_) {
+        throw std::runtime_error("Failed to open trajectory file: " + path_);
+    }
+
+    TrajectoryHeader header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.encoding = static_cast<std::uint32_t>(encoding_);
+    header.dimension = dimension;
+    header.stride = stride_;
+    header.rowBytes = rowBytes_;
+    file_.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+// Keeps the rows before `firstIteration` of an existing file and restores
+// the delta encoder's state from the last of them. False if there is no
+// file to continue.
+bool TrajectoryLogger::reopen(std::uint64_t firstIteration) {
+    struct stat info {};
+    if (::stat(path_.c_str(), &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(TrajectoryHeader)) {
+        return false;
+    }
+    std::size_t kept = 0;
+    {
+        TrajectoryReader reader(path_);
+        if (reader.encoding() != encoding_ || reader.dimension() != dimension_ || reader.stride() != stride_) {
+            throw std::runtime_error("Cannot append to trajectory file with different settings: " + path_);
+        }
+        TrajectoryRecord record;
+        while (reader.next(record) && record.iteration < firstIteration) {
+            decoded_ = record.parameters;
+            ++kept;
+        }
+    }
+    std::filesystem::resize_file(path_, sizeof(TrajectoryHeader) + kept * rowBytes_);
+    file_.open(path_, std::ios::out | std::ios::app | std::ios::binary);
+    if (!file_) {
+        throw std::runtime_error("Failed to open trajectory file: " + path_);
+    }
+    return true;
+}
+
+void TrajectoryLogger::flushBuffer() {
+    if (used_ == 0) return;
+    file_.write(buffer_.data(), static_cast<std::streamsize>(used_));
+    used_ = 0;
+    if (!file_) {
+        throw std::runtime_error("Failed to write trajectory file: " + path_);
+    }
+}
+
+void TrajectoryLogger::onIteration(TrainerState& state) {
+    if (state.iteration % stride_ != 0) return;
+    if (!file_.is_open()) {
+        open(state.parameters.size(), state.iteration);
+    }
+    if (state.parameters.size() != dimension_) {
+        throw std::invalid_argument("Vector dimension mismatch");
+    }
+    if (used_ + rowBytes_ > buffer_.size()) {
+        flushBuffer();
+    }
+
+    char* out = buffer_.data() + used_;
+    out = put<std::uint64_t>(out, state.iteration);
+    switch (encoding_) {
+        case TrajectoryEncoding::Float64:
+            out = put(out, state.value);
+            out = put(out, state.gradNormInf);
+            out = put(out, state.config.learningRate);
+            for (double xi : state.parameters) {
+                out = put(out, xi);
+            }
+            break;
+        case TrajectoryEncoding::Float32:
+            out = put(out, static_cast<float>(state.value));
+            out = put(out, static_cast<float>(state.gradNormInf));
+            out = put(out, static_cast<float>(state.config.learningRate));
+            for (double xi : state.parameters) {
+                out = put(out, static_cast<float>(xi));
+            }
+            break;
+        case TrajectoryEncoding::DeltaFloat32:
+            out = put(out, static_cast<float>(state.value));
+            out = put(out, static_cast<float>(state.gradNormInf));
+            out = put(out, static_cast<float>(state.config.learningRate));
+            for (std::size_t i = 0; i < dimension_; ++i) {
+                const float delta = static_cast<float>(state.parameters[i] - decoded_[i]);
+                decoded_[i] += delta;
+                out = put(out, delta);
+            }
+            break;
+    }
+    used_ += rowBytes_;
+}
+
+// ------------------------- Trajectory Reader -------------------------
+TrajectoryReader::TrajectoryReader(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Failed to open trajectory file: " + path);
+    }
+    struct stat info {};
+    if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < sizeof(TrajectoryHeader)) {
+        ::close(fd);
+        throw std::runtime_error("Not a trajectory file: " + path);
+    }
+    size_ = static_cast<std::size_t>(info.st_size);
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        throw std::runtime_error("Failed to map trajectory file: " + path);
+    }
+    data_ = static_cast<const unsigned char*>(mapped);
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+
+    TrajectoryHeader header{};
+    std::memcpy(&header, data_, sizeof(header));
+    const bool validEncoding = header.encoding <= static_cast<std::uint32_t>(TrajectoryEncoding::DeltaFloat32);
+    if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 || header.version != kVersion || !validEncoding) {
+        ::munmap(mapped, size_);
+        throw std::runtime_error("Not a trajectory file: " + path);
+    }
+    encoding_ = static_cast<TrajectoryEncoding>(header.encoding);
+    dimension_ = static_cast<std::size_t>(header.dimension);
+    stride_ = static_cast<std::size_t>(header.stride);
+    rowBytes_ = rowBytesFor(encoding_, dimension_);
+    if (header.rowBytes != rowBytes_) {
+        ::munmap(mapped, size_);
+        throw std::runtime_error("Corrupt trajectory header: " + path);
+    }
+    rowCount_ = (size_ - sizeof(TrajectoryHeader)) / rowBytes_;
+    decoded_.assign(dimension_, 0.0);
+}
+
+TrajectoryReader::~TrajectoryReader() {
+    if (data_) {
+        ::munmap(const_cast<unsigned char*>(data_), size_);
+    }
+}
+
+void TrajectoryReader::rewind() {
+    nextRow_ = 0;
+    std::fill(decoded_.begin(), decoded_.end(), 0.0);
+}
+
+bool TrajectoryReader::next(TrajectoryRecord& record) {
+    if (nextRow_ >= rowCount_) return false;
+
+    const unsigned char* in = data_ + sizeof(TrajectoryHeader) + nextRow_ * rowBytes_;
+    ++nextRow_;
+
+    in = get(in, record.iteration);
+    in = getScalar(in, encoding_, record.value);
+    in = getScalar(in, encoding_, record.gradNormInf);
+    in = getScalar(in, encoding_, record.learningRate);
+    record.parameters.resize(dimension_);
+    if (encoding_ == TrajectoryEncoding::DeltaFloat32) {
+        for (std::size_t i = 0; i < dimension_; ++i) {
+            float delta = 0.0f;
+            in = get(in, delta);
+            decoded_[i] += delta;
+            record.parameters[i] = decoded_[i];
+        }
+    } else {
+        for (std::size_t i = 0; i < dimension_; ++i) {
+            in = getScalar(in, encoding_, record.parameters[i]);
+        }
+    }
+    return true;
+}
+
+} // namespace gd
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "simplex/simplex.hpp"
+
+#include <cstddef>
+
+namespace simplex {
+
+struct InteriorPointOptions {
+    std::size_t maxIterations{100};
+    double tolerance{1e-8};     // relative primal/dual residual and duality gap
+    std::size_t threads{0};     // 0 = hardware concurrency
+    std::size_t blockSize{64};  // Cholesky panel width
+    bool crossover{false};      // finish at a vertex via SimplexSolver::solveFrom
+};
+
+struct InteriorPointInfo {
+    std::size_t iterations{0};
+    double primalResidual{0.0};  // ||b - A x - s||_inf / (1 + ||b||_inf)
+    double dualResidual{0.0};    // relative, same scaling by ||c||_inf
+    double gap{0.0};             // |primal - dual objective| / (1 + |primal objective|)
+    bool crossedOver{false};
+};
+
+// Primal-dual interior-point method (Mehrotra predictor-corrector) for the
+// same problems as SimplexSolver: maximize c^T x subject to A x <= b, x >= 0.
+// Each iteration factors the normal equations A D A^T + D_s with a blocked,
+// multithreaded dense Cholesky, so the iteration count stays in the tens
+// regardless of size where the tableau's pivot count keeps growing.
+// Negative right-hand sides are handled (no phase 1 needed). Without
+// crossover the solution is interior to the optimal face, not necessarily
+// a vertex.
+class InteriorPointSolver {
+public:
+    InteriorPointSolver() = default;
+    explicit InteriorPointSolver(InteriorPointOptions options) : options_(options) {}
+
+    Solution solve(const Problem &problem, InteriorPointInfo *info = nullptr) const;
+
+    const InteriorPointOptions &options() const noexcept { return options_; }
+
+private:
+    InteriorPointOptions options_;
+};
+
+} // namespace simplex
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -18,7 +20,10 @@ enum class Status {
     Optimal,
     Unbounded,
     Infeasible,
-    InvalidInput
+    InvalidInput,
+    IterationLimit,
+    InfeasibleStart,  // solveFrom: the warm-start point violates the constraints
+    Cancelled         // SimplexOptions::cancel was set before the solve finished
 };
 
 struct Solution {
@@ -27,12 +32,54 @@ struct Solution {
     double objective{0.0};
 };
 
+// Scratch storage for the tableau. Reusing one per thread across solves
+// avoids reallocating it; capacity grows to the largest problem seen.
+struct Workspace {
+    std::vector<double> tableau;
+    std::vector<std::size_t> basis;
+};
+
+// Pivoting uses Dantzig's rule. After `degenerateRun` consecutive pivots
+// that leave the objective unchanged it switches to Bland's rule, which
+// cannot cycle, until a pivot makes progress again.
+struct SimplexOptions {
+    std::size_t maxPivots{0};                  // Status::IterationLimit beyond this; 0 = no limit
+    std::size_t degenerateRun{32};
+    const std::atomic<bool> *cancel{nullptr};  // checked before every pivot
+};
+
 class SimplexSolver {
 public:
+    SimplexSolver() = default;
+    explicit SimplexSolver(SimplexOptions options) : options_(options) {}
+
     Solution solve(const Problem &problem) const;
+    Solution solve(const Problem &problem, Workspace &workspace) const;
+
+    // Warm start from a feasible point `point` (numVariables entries, e.g.
+    // an interior-point solution): pushes it to a vertex that is no worse,
+    // then continues with simplex pivots, so the result is a basic optimal
+    // solution. Unlike solve(), negative right-hand sides are fine as long
+    // as the point is feasible. If it is not, the result is solve()'s when
+    // every b_i >= 0 and Status::InfeasibleStart otherwise (solve() would
+    // wrongly call such a problem infeasible); the caller decides what next.
+    Solution solveFrom(const Problem &problem, const std::vector<double> &point, Workspace &workspace) const;
+
+    const SimplexOptions &options() const noexcept { return options_; }
+
+private:
+    SimplexOptions options_;
 };
 
 std::string statusToString(Status status);
 
+// Reads the text format used by simplex_cli:
+//   <num_constraints> <num_variables>
+//   <objective coefficients...>
+//   constraint rows: <coefficients...> <rhs>
+// Blank lines and lines starting with # are ignored. Throws
+// std::runtime_error on malformed input.
+Problem readProblem(std::istream &in);
+
 } // namespace simplex
 
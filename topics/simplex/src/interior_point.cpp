@@ -0,0 +1,565 @@
+#include "simplex/interior_point.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace simplex {
+namespace {
+
+constexpr double kStepFraction = 0.9995;     // stay this far inside the boundary
+constexpr double kTinyPivot = 1e-30;         // relative to the largest diagonal
+constexpr double kHugePivot = 1e128;         // replaces a dropped pivot
+constexpr double kDivergence = 1e12;         // iterate size that signals a ray
+constexpr double kProgress = 0.9;            // residual decrease that counts as progress
+constexpr std::size_t kStallIterations = 10; // iterations without progress ...
+constexpr double kStallResidual = 1e-4;      // ... at a residual this far from converged
+constexpr double kRayRatio = 1e3;            // iterate size ratio that identifies the ray
+constexpr std::size_t kParallelRows = 64;    // smaller problems stay on one thread
+
+using Range = std::function<void(std::size_t, std::size_t)>;
+
+// Fork-join workers that live for one solve. run() hands out [begin, end)
+// chunks of `count` items from a shared counter, so rows of uneven cost
+// (triangular updates) balance across threads. The caller works too.
+class Team {
+public:
+    explicit Team(std::size_t workers) {
+        for (std::size_t i = 0; i < workers; ++i) {
+            workers_.emplace_back([this] { work(); });
+        }
+    }
+
+    ~Team() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+        for (std::thread &worker : workers_) {
+            worker.join();
+        }
+    }
+
+    Team(const Team &) = delete;
+    Team &operator=(const Team &) = delete;
+
+    void run(std::size_t count, std::size_t grain, const Range &body) {
+        grain = std::max<std::size_t>(grain, 1);
+        if (workers_.empty() || count <= grain) {
+            if (count > 0) body(0, count);
+            return;
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            body_ = &body;
+            count_ = count;
+            grain_ = grain;
+            next_.store(0, std::memory_order_relaxed);
+            active_ = workers_.size();
+            ++generation_;
+        }
+        start_.notify_all();
+        drain();
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [this] { return active_ == 0; });
+        body_ = nullptr;
+    }
+
+private:
+    void work() {
+        std::size_t seen = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_) return;
+                seen = generation_;
+            }
+            drain();
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--active_ == 0) done_.notify_one();
+        }
+    }
+
+    void drain() {
+        std::size_t begin;
+        while ((begin = next_.fetch_add(grain_, std::memory_order_relaxed)) < count_) {
+            (*body_)(begin, std::min(begin + grain_, count_));
+        }
+    }
+
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    const Range *body_ = nullptr;
+    std::size_t count_ = 0;
+    std::size_t grain_ = 1;
+    std::atomic<std::size_t> next_{0};
+    std::size_t generation_ = 0;
+    std::size_t active_ = 0;
+    bool stop_ = false;
+};
+
+// Independent partial sums so the compiler can vectorise without
+// reassociating (same scheme as the gd kernels)
+double dot(const double *a, const double *b, std::size_t n) {
+    constexpr std::size_t kLanes = 8;
+    double acc[kLanes] = {};
+    std::size_t k = 0;
+    for (; k + kLanes <= n; k += kLanes) {
+        for (std::size_t lane = 0; lane < kLanes; ++lane) {
+            acc[lane] += a[k + lane] * b[k + lane];
+        }
+    }
+    double tail = 0.0;
+    for (; k < n; ++k) {
+        tail += a[k] * b[k];
+    }
+    return ((acc[0] + acc[1]) + (acc[2] + acc[3])) + ((acc[4] + acc[5]) + (acc[6] + acc[7])) + tail;
+}
+
+double normInf(const std::vector<double> &v) {
+    double norm = 0.0;
+    for (double value : v) {
+        norm = std::max(norm, std::fabs(value));
+    }
+    return norm;
+}
+
+// Largest alpha in (0, 1] keeping v + alpha * dv >= 0
+double maxStep(const std::vector<double> &v, const std::vector<double> &dv) {
+    double alpha = 1.0;
+    for (std::size_t i = 0; i < v.size(); ++i) {
+        if (dv[i] < 0.0) {
+            alpha = std::min(alpha, -v[i] / dv[i]);
+        }
+    }
+    return alpha;
+}
+
+// ------------------------- Dense kernels -------------------------
+class NormalEquations {
+public:
+    NormalEquations(const Problem &problem, Team &team, std::size_t blockSize)
+        : A_(problem.A),
+          m_(problem.numConstraints),
+          n_(problem.numVariables),
+          team_(team),
+          blockSize_(std::max<std::size_t>(blockSize, 8)),
+          scaled_(m_ * n_),
+          factor_(m_ * m_) {}
+
+    // out = A x
+    void multiply(const std::vector<double> &x, std::vector<double> &out) {
+        out.resize(m_);
+        team_.run(m_, 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                out[i] = dot(A_.data() + i * n_, x.data(), n_);
+            }
+        });
+    }
+
+    // out = A^T y, split by column ranges so threads never share an output
+    void multiplyTransposed(const std::vector<double> &y, std::vector<double> &out) {
+        out.assign(n_, 0.0);
+        team_.run(n_, 256, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = 0; i < m_; ++i) {
+                const double *row = A_.data() + i * n_;
+                const double yi = y[i];
+                for (std::size_t j = begin; j < end; ++j) {
+                    out[j] += row[j] * yi;
+                }
+            }
+        });
+    }
+
+    // Forms and factors M = A diag(dx) A^T + diag(ds) = L L^T
+    void factor(const std::vector<double> &dx, const std::vector<double> &ds) {
+        std::vector<double> root(n_);
+        for (std::size_t j = 0; j < n_; ++j) {
+            root[j] = std::sqrt(dx[j]);
+        }
+        team_.run(m_, 16, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; ++i) {
+                const double *row = A_.data() + i * n_;
+                double *out = scaled_.data() + i * n_;
+                for (std::size_t j = 0; j < n_; ++j) {
+                    out[j] = row[j] * root[j];
+                }
+            }
+        });
+        formProduct(ds);
+        cholesky();
+    }
+
+    // Solves L L^T x = rhs in place
+    void solve(std::vector<double> &rhs) const {
+        const double *L = factor_.data();
+        for (std::size_t i = 0; i < m_; ++i) {
+            rhs[i] = (rhs[i] - dot(L + i * m_, rhs.data(), i)) / L[i * m_ + i];
+        }
+        for (std::size_t i = m_; i-- > 0;) {
+            rhs[i] /= L[i * m_ + i];
+            const double xi = rhs[i];
+            const double *row = L + i * m_;
+            for (std::size_t k = 0; k < i; ++k) {
+                rhs[k] -= row[k] * xi;
+            }
+        }
+    }
+
+private:
+    // Lower triangle of W W^T + diag(ds), W = scaled_. Tiled so a block of
+    // rows of W is reused from cache against a block of columns.
+    void formProduct(const std::vector<double> &ds) {
+        const std::size_t tile = 32;
+        const std::size_t depth = 512;
+        const std::size_t tiles = (m_ + tile - 1) / tile;
+        team_.run(tiles, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t bi = begin; bi < end; ++bi) {
+                const std::size_t i0 = bi * tile;
+                const std::size_t i1 = std::min(i0 + tile, m_);
+                for (std::size_t i = i0; i < i1; ++i) {
+                    std::fill(factor_.data() + i * m_, factor_.data() + i * m_ + i + 1, 0.0);
+                }
+                for (std::size_t k0 = 0; k0 < n_; k0 += depth) {
+                    const std::size_t kn = std::min(depth, n_ - k0);
+                    for (std::size_t j0 = 0; j0 <= i0; j0 += tile) {
+                        const std::size_t j1 = std::min(j0 + tile, m_);
+                        for (std::size_t i = i0; i < i1; ++i) {
+                            const double *wi = scaled_.data() + i * n_ + k0;
+                            double *out = factor_.data() + i * m_;
+                            for (std::size_t j = j0; j < std::min(j1, i + 1); ++j) {
+                                out[j] += dot(wi, scaled_.data() + j * n_ + k0, kn);
+                            }
+                        }
+                    }
+                }
+                for (std::size_t i = i0; i < i1; ++i) {
+                    factor_[i * m_ + i] += ds[i];
+                }
+            }
+        });
+    }
+
+    // Right-looking blocked Cholesky on the lower triangle (row-major).
+    // Per panel: factor the diagonal block, solve the rows below it, then
+    // update the trailing matrix; the last two run on the team. A pivot that
+    // collapses (rank deficiency near the optimum) is replaced by a huge
+    // value, which zeroes that component of the solution instead of failing.
+    void cholesky() {
+        double *M = factor_.data();
+        double maxDiagonal = 0.0;
+        for (std::size_t i = 0; i < m_; ++i) {
+            maxDiagonal = std::max(maxDiagonal, M[i * m_ + i]);
+        }
+        const double tiny = kTinyPivot * std::max(maxDiagonal, 1.0);
+
+        for (std::size_t k0 = 0; k0 < m_; k0 += blockSize_) {
+            const std::size_t k1 = std::min(k0 + blockSize_, m_);
+
+            for (std::size_t j = k0; j < k1; ++j) {
+                double *rowJ = M + j * m_;
+                double diagonal = rowJ[j] - dot(rowJ + k0, rowJ + k0, j - k0);
+                if (!(diagonal > tiny)) {
+                    diagonal = kHugePivot;
+                }
+                rowJ[j] = std::sqrt(diagonal);
+                for (std::size_t i = j + 1; i < k1; ++i) {
+                    double *rowI = M + i * m_;
+                    rowI[j] = (rowI[j] - dot(rowI + k0, rowJ + k0, j - k0)) / rowJ[j];
+                }
+            }
+
+            if (k1 == m_) break;
+            team_.run(m_ - k1, 8, [&](std::size_t begin, std::size_t end) {
+                for (std::size_t i = k1 + begin; i < k1 + end; ++i) {
+                    double *rowI = M + i * m_;
+                    for (std::size_t j = k0; j < k1; ++j) {
+                        const double *rowJ = M + j * m_;
+                        rowI[j] = (rowI[j] - dot(rowI + k0, rowJ + k0, j - k0)) / rowJ[j];
+                    }
+                }
+            });
+            team_.run(m_ - k1, 4, [&](std::size_t begin, std::size_t end) {
+                const std::size_t width = k1 - k0;
+                for (std::size_t i = k1 + begin; i < k1 + end; ++i) {
+                    double *rowI = M + i * m_;
+                    for (std::size_t j = k1; j <= i; ++j) {
+                        rowI[j] -= dot(rowI + k0, M + j * m_ + k0, width);
+                    }
+                }
+            });
+        }
+    }
+
+    const std::vector<double> &A_;
+    std::size_t m_;
+    std::size_t n_;
+    Team &team_;
+    std::size_t blockSize_;
+    std::vector<double> scaled_;   // A diag(sqrt(dx))
+    std::vector<double> factor_;   // M, then L in its lower triangle
+};
+
+} // namespace
+
+// The LP is solved in equality form over (x, s):
+//     minimize -c^T x  subject to  A x + s = b,  x, s >= 0,
+// with dual variables y (rows) and reduced costs zx, zs >= 0:
+//     A^T y + zx = -c,  y + zs = 0.
+Solution InteriorPointSolver::solve(const Problem &problem, InteriorPointInfo *info) const {
+    Solution solution;
+    solution.status = Status::InvalidInput;
+    InteriorPointInfo localInfo;
+    InteriorPointInfo &stats = info != nullptr ? *info : localInfo;
+    stats = InteriorPointInfo{};
+
+    const std::size_t m = problem.numConstraints;
+    const std::size_t n = problem.numVariables;
+    if (m == 0 || n == 0) {
+        return solution;
+    }
+    if (problem.A.size() != m * n || problem.b.size() != m || problem.c.size() != n) {
+        return solution;
+    }
+
+    std::size_t threads = options_.threads != 0 ? options_.threads : std::thread::hardware_concurrency();
+    if (m < kParallelRows) {
+        threads = 1;
+    }
+    Team team(std::max<std::size_t>(threads, 1) - 1);
+    NormalEquations normal(problem, team, options_.blockSize);
+
+    const std::vector<double> &b = problem.b;
+    std::vector<double> cost(n);   // -c: the minimisation objective
+    for (std::size_t j = 0; j < n; ++j) {
+        cost[j] = -problem.c[j];
+    }
+    const double bNorm = normInf(b);
+    const double cNorm = normInf(cost);
+    const double divergence = kDivergence * (1.0 + std::max({bNorm, cNorm, normInf(problem.A)}));
+
+    std::vector<double> x(n), s(m), y(m), zx(n), zs(m);
+    std::vector<double> work(n), rows(m);
+
+    // Mehrotra's starting point: least-norm x for A x + s = b and least
+    // squares duals, shifted into the positive orthant
+    {
+        normal.factor(std::vector<double>(n, 1.0), std::vector<double>(m, 1.0));
+        rows = b;
+        normal.solve(rows);
+        normal.multiplyTransposed(rows, x);
+        s = rows;
+        normal.multiply(cost, y);
+        normal.solve(y);
+        normal.multiplyTransposed(y, work);
+        for (std::size_t j = 0; j < n; ++j) zx[j] = cost[j] - work[j];
+        for (std::size_t i = 0; i < m; ++i) zs[i] = -y[i];
+
+        double minPrimal = std::numeric_limits<double>::infinity();
+        double minDual = std::numeric_limits<double>::infinity();
+        for (double v : x) minPrimal = std::min(minPrimal, v);
+        for (double v : s) minPrimal = std::min(minPrimal, v);
+        for (double v : zx) minDual = std::min(minDual, v);
+        for (double v : zs) minDual = std::min(minDual, v);
+        const double shiftPrimal = std::max(-1.5 * minPrimal, 0.0);
+        const double shiftDual = std::max(-1.5 * minDual, 0.0);
+        double product = 0.0;
+        double sumPrimal = 0.0;
+        double sumDual = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            product += (x[j] + shiftPrimal) * (zx[j] + shiftDual);
+            sumPrimal += x[j] + shiftPrimal;
+            sumDual += zx[j] + shiftDual;
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            product += (s[i] + shiftPrimal) * (zs[i] + shiftDual);
+            sumPrimal += s[i] + shiftPrimal;
+            sumDual += zs[i] + shiftDual;
+        }
+        const double extraPrimal = sumDual > 0.0 ? 0.5 * product / sumDual : 0.0;
+        const double extraDual = sumPrimal > 0.0 ? 0.5 * product / sumPrimal : 0.0;
+        // Keep a floor so a degenerate start (e.g. b = 0, c = 0) is interior
+        const double primalOffset = std::max(shiftPrimal + extraPrimal, 1e-2);
+        const double dualOffset = std::max(shiftDual + extraDual, 1e-2);
+        for (double &v : x) v += primalOffset;
+        for (double &v : s) v += primalOffset;
+        for (double &v : zx) v += dualOffset;
+        for (double &v : zs) v += dualOffset;
+    }
+
+    const double count = static_cast<double>(n + m);
+    std::vector<double> rp(m), rdx(n), rds(m);
+    std::vector<double> dx(n), ds(m);
+    std::vector<double> rcx(n), rcs(m);
+    std::vector<double> stepX(n), stepS(m), stepY(m), stepZx(n), stepZs(m);
+    std::vector<double> affineX(n), affineS(m), affineZx(n), affineZs(m);
+
+    // Solves the Newton system for complementarity targets (rcx, rcs),
+    // reusing the current factorisation
+    auto newtonStep = [&]() {
+        for (std::size_t j = 0; j < n; ++j) work[j] = dx[j] * rdx[j] - rcx[j] / zx[j];
+        normal.multiply(work, rows);
+        for (std::size_t i = 0; i < m; ++i) {
+            stepY[i] = rp[i] + rows[i] + ds[i] * rds[i] - rcs[i] / zs[i];
+        }
+        normal.solve(stepY);
+        normal.multiplyTransposed(stepY, work);
+        for (std::size_t j = 0; j < n; ++j) {
+            stepZx[j] = rdx[j] - work[j];
+            stepX[j] = (rcx[j] - x[j] * stepZx[j]) / zx[j];
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            stepZs[i] = rds[i] - stepY[i];
+            stepS[i] = (rcs[i] - s[i] * stepZs[i]) / zs[i];
+        }
+    };
+
+    Status status = Status::IterationLimit;
+    double bestPrimal = std::numeric_limits<double>::infinity();
+    double bestDual = std::numeric_limits<double>::infinity();
+    std::size_t primalStall = 0;
+    std::size_t dualStall = 0;
+    for (std::size_t iteration = 0; iteration <= options_.maxIterations; ++iteration) {
+        stats.iterations = iteration;
+
+        // Residuals and convergence
+        normal.multiply(x, rows);
+        for (std::size_t i = 0; i < m; ++i) rp[i] = b[i] - rows[i] - s[i];
+        normal.multiplyTransposed(y, work);
+        for (std::size_t j = 0; j < n; ++j) rdx[j] = cost[j] - work[j] - zx[j];
+        for (std::size_t i = 0; i < m; ++i) rds[i] = -y[i] - zs[i];
+
+        double primalObjective = 0.0;
+        double dualObjective = 0.0;
+        double complementarity = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            primalObjective += cost[j] * x[j];
+            complementarity += x[j] * zx[j];
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            dualObjective += b[i] * y[i];
+            complementarity += s[i] * zs[i];
+        }
+        stats.primalResidual = normInf(rp) / (1.0 + bNorm);
+        stats.dualResidual = std::max(normInf(rdx), normInf(rds)) / (1.0 + cNorm);
+        stats.gap = std::fabs(primalObjective - dualObjective) / (1.0 + std::fabs(primalObjective));
+        if (stats.primalResidual < options_.tolerance && stats.dualResidual < options_.tolerance &&
+            stats.gap < options_.tolerance) {
+            status = Status::Optimal;
+            break;
+        }
+
+        // Without an optimum an infeasible-start method either follows a ray
+        // (primal iterates grow: unbounded; duals grow: a Farkas certificate
+        // of infeasibility) or stalls with one residual stuck while the
+        // other goes to zero. Near-converged stalls are left to the
+        // iteration limit.
+        const double primalSize = std::max(normInf(x), normInf(s));
+        const double dualSize = std::max({normInf(y), normInf(zx), normInf(zs)});
+        if (primalSize > divergence && primalSize > dualSize) {
+            status = Status::Unbounded;
+            break;
+        }
+        if (dualSize > divergence) {
+            status = Status::Infeasible;
+            break;
+        }
+        primalStall = stats.primalResidual < kProgress * bestPrimal ? 0 : primalStall + 1;
+        dualStall = stats.dualResidual < kProgress * bestDual ? 0 : dualStall + 1;
+        bestPrimal = std::min(bestPrimal, stats.primalResidual);
+        bestDual = std::min(bestDual, stats.dualResidual);
+        const bool primalStuck = primalStall >= kStallIterations && stats.primalResidual > kStallResidual;
+        const bool dualStuck = dualStall >= kStallIterations && stats.dualResidual > kStallResidual;
+        if (primalStuck || dualStuck) {
+            // Both can stall at once; then the side that is running away
+            // along a ray tells which certificate is forming
+            if (primalSize > kRayRatio * dualSize) {
+                status = Status::Unbounded;
+            } else if (dualSize > kRayRatio * primalSize) {
+                status = Status::Infeasible;
+            } else {
+                status = primalStuck ? Status::Infeasible : Status::Unbounded;
+            }
+            break;
+        }
+        if (iteration == options_.maxIterations) {
+            break;
+        }
+
+        for (std::size_t j = 0; j < n; ++j) dx[j] = x[j] / zx[j];
+        for (std::size_t i = 0; i < m; ++i) ds[i] = s[i] / zs[i];
+        normal.factor(dx, ds);
+
+        // Predictor: pure Newton step towards complementarity zero
+        for (std::size_t j = 0; j < n; ++j) rcx[j] = -x[j] * zx[j];
+        for (std::size_t i = 0; i < m; ++i) rcs[i] = -s[i] * zs[i];
+        newtonStep();
+        const double affinePrimal = std::min(maxStep(x, stepX), maxStep(s, stepS));
+        const double affineDual = std::min(maxStep(zx, stepZx), maxStep(zs, stepZs));
+        double affineComplementarity = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            affineComplementarity += (x[j] + affinePrimal * stepX[j]) * (zx[j] + affineDual * stepZx[j]);
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            affineComplementarity += (s[i] + affinePrimal * stepS[i]) * (zs[i] + affineDual * stepZs[i]);
+        }
+        const double mu = complementarity / count;
+        const double ratio = affineComplementarity / complementarity;
+        const double sigma = ratio * ratio * ratio;
+
+        // Corrector: centring plus the second-order term of the predictor
+        affineX = stepX;
+        affineS = stepS;
+        affineZx = stepZx;
+        affineZs = stepZs;
+        for (std::size_t j = 0; j < n; ++j) rcx[j] = sigma * mu - x[j] * zx[j] - affineX[j] * affineZx[j];
+        for (std::size_t i = 0; i < m; ++i) rcs[i] = sigma * mu - s[i] * zs[i] - affineS[i] * affineZs[i];
+        newtonStep();
+
+        const double alphaPrimal = std::min(1.0, kStepFraction * std::min(maxStep(x, stepX), maxStep(s, stepS)));
+        const double alphaDual = std::min(1.0, kStepFraction * std::min(maxStep(zx, stepZx), maxStep(zs, stepZs)));
+        for (std::size_t j = 0; j < n; ++j) {
+            x[j] += alphaPrimal * stepX[j];
+            zx[j] += alphaDual * stepZx[j];
+        }
+        for (std::size_t i = 0; i < m; ++i) {
+            s[i] += alphaPrimal * stepS[i];
+            y[i] += alphaDual * stepY[i];
+            zs[i] += alphaDual * stepZs[i];
+        }
+    }
+
+    solution.status = status;
+    if (status != Status::Optimal) {
+        return solution;
+    }
+
+    if (options_.crossover) {
+        Workspace workspace;
+        Solution vertex = SimplexSolver().solveFrom(problem, x, workspace);
+        if (vertex.status == Status::Optimal) {
+            stats.crossedOver = true;
+            return vertex;
+        }
+    }
+
+    solution.variables.resize(n);
+    solution.objective = 0.0;
+    for (std::size_t j = 0; j < n; ++j) {
+        solution.variables[j] = std::max(x[j], 0.0);
+        solution.objective += problem.c[j] * solution.variables[j];
+    }
+    return solution;
+}
+
+} // namespace simplex
@@ -0,0 +1,92 @@
+#include "simplex/simplex.hpp"
+
+#include <cctype>
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace simplex {
+namespace {
+
+std::string trim(const std::string &line) {
+    std::size_t start = 0;
+    while (start < line.size() && std::isspace(static_cast<unsigned char>(line[start]))) {
+        ++start;
+    }
+    std::size_t end = line.size();
+    while (end > start && std::isspace(static_cast<unsigned char>(line[end - 1]))) {
+        --end;
+    }
+    return line.substr(start, end - start);
+}
+
+bool readEffectiveLine(std::istream &in, std::string &line) {
+    while (std::getline(in, line)) {
+        const std::string trimmed = trim(line);
+        if (trimmed.empty() || trimmed.front() == '#') {
+            continue;
+        }
+        line = trimmed;
+        return true;
+    }
+    return false;
+}
+
+} // namespace
+
+Problem readProblem(std::istream &in) {
+    Problem problem;
+    std::string line;
+    if (!readEffectiveLine(in, line)) {
+        throw std::runtime_error("Input is empty");
+    }
+
+    {
+        std::istringstream iss(line);
+        if (!(iss >> problem.numConstraints >> problem.numVariables)) {
+            throw std::runtime_error("Failed to parse problem dimensions");
+        }
+    }
+
+    if (problem.numConstraints == 0 || problem.numVariables == 0) {
+        throw std::runtime_error("Problem dimensions must be positive");
+    }
+
+    if (!readEffectiveLine(in, line)) {
+        throw std::runtime_error("Missing objective coefficients");
+    }
+
+    {
+        std::istringstream iss(line);
+        problem.c.resize(problem.numVariables);
+        for (std::size_t j = 0; j < problem.numVariables; ++j) {
+            if (!(iss >> problem.c[j])) {
+                throw std::runtime_error("Failed to parse objective coefficient " + std::to_string(j));
+            }
+        }
+    }
+
+    problem.A.resize(problem.numConstraints * problem.numVariables);
+    problem.b.resize(problem.numConstraints);
+
+    for (std::size_t i = 0; i < problem.numConstraints; ++i) {
+        if (!readEffectiveLine(in, line)) {
+            throw std::runtime_error("Missing constraint row " + std::to_string(i));
+        }
+        std::istringstream iss(line);
+        for (std::size_t j = 0; j < problem.numVariables; ++j) {
+            if (!(iss >> problem.A[i * problem.numVariables + j])) {
+                throw std::runtime_error("Failed to parse constraint coefficient (" +
+                                         std::to_string(i) + ", " + std::to_string(j) + ")");
+            }
+        }
+        if (!(iss >> problem.b[i])) {
+            throw std::runtime_error("Failed to parse constraint RHS " + std::to_string(i));
+        }
+    }
+
+    return problem;
+}
+
+} // namespace simplex
@@ -13,8 +13,10 @@ constexpr double kEps = 1e-9;
 
 class Tableau {
 public:
-    Tableau(std::size_t height, std::size_t width)
-        : width_(width), height_(height), data_(height * width, 0.0) {}
+    Tableau(std::size_t height, std::size_t width, std::vector<double> &storage)
+        : width_(width), height_(height), data_(storage) {
+        data_.assign(height * width, 0.0);
+    }
 
     double &operator()(std::size_t row, std::size_t col) {
         return data_[row * width_ + col];
@@ -33,9 +35,147 @@ public:
 private:
     std::size_t width_;
     std::size_t height_;
-    std::vector<double> data_;
+    std::vector<double> &data_;
 };
 
+// Gauss-Jordan pivot on (pivotRow, pivotCol), objective row included
+void pivot(Tableau &tableau, std::size_t pivotRow, std::size_t pivotCol) {
+    const std::size_t width = tableau.width();
+    const double invPivot = 1.0 / tableau(pivotRow, pivotCol);
+    for (std::size_t j = 0; j < width; ++j) {
+        tableau(pivotRow, j) *= invPivot;
+    }
+
+    for (std::size_t i = 0; i < tableau.height(); ++i) {
+        if (i == pivotRow) {
+            continue;
+        }
+        const double factor = tableau(i, pivotCol);
+        if (std::fabs(factor) <= kEps) {
+            continue;
+        }
+        for (std::size_t j = 0; j < width; ++j) {
+            tableau(i, j) -= factor * tableau(pivotRow, j);
+        }
+    }
+}
+
+// Primal simplex from a primal feasible tableau whose last row is the
+// objective. Dantzig's rule, falling back to Bland's (lowest index enters,
+// lowest basic index leaves among ratio ties) during long degenerate runs.
+Status iterate(Tableau &tableau, std::vector<std::size_t> &basis, const SimplexOptions &options) {
+    const std::size_t width = tableau.width();
+    const std::size_t height = tableau.height();
+    const std::size_t m = height - 1;
+    const std::size_t objectiveRow = m;
+
+    std::size_t pivots = 0;
+    std::size_t degenerate = 0;
+    while (true) {
+        const bool bland = degenerate >= options.degenerateRun;
+        double mostNegative = 0.0;
+        std::size_t pivotCol = width; // invalid sentinel
+        for (std::size_t j = 0; j < width - 1; ++j) {
+            const double coeff = tableau(objectiveRow, j);
+            if (coeff < mostNegative - kEps) {
+                mostNegative = coeff;
+                pivotCol = j;
+                if (bland) {
+                    break;
+                }
+            }
+        }
+
+        if (pivotCol == width) {
+            return Status::Optimal;
+        }
+        if (options.maxPivots != 0 && pivots == options.maxPivots) {
+            return Status::IterationLimit;
+        }
+        if (options.cancel != nullptr && options.cancel->load(std::memory_order_relaxed)) {
+            return Status::Cancelled;
+        }
+
+        double bestRatio = std::numeric_limits<double>::infinity();
+        std::size_t pivotRow = height; // invalid sentinel
+        for (std::size_t i = 0; i < m; ++i) {
+            const double coeff = tableau(i, pivotCol);
+            if (coeff > kEps) {
+                const double rhs = tableau(i, width - 1);
+                const double ratio = rhs / coeff;
+                const bool tie = bland && pivotRow != height && ratio <= bestRatio + kEps;
+                if (ratio < bestRatio - kEps || (tie && basis[i] < basis[pivotRow])) {
+                    bestRatio = ratio;
+                    pivotRow = i;
+                }
+            }
+        }
+
+        if (pivotRow == height) {
+            return Status::Unbounded;
+        }
+
+        if (std::fabs(tableau(pivotRow, pivotCol)) < kEps) {
+            return Status::InvalidInput;
+        }
+
+        degenerate = bestRatio <= kEps ? degenerate + 1 : 0;
+        pivot(tableau, pivotRow, pivotCol);
+        basis[pivotRow] = pivotCol;
+        ++pivots;
+    }
+}
+
+bool validShape(const Problem &problem) {
+    const std::size_t m = problem.numConstraints;
+    const std::size_t n = problem.numVariables;
+    return m != 0 && n != 0 && problem.A.size() == m * n && problem.b.size() == m && problem.c.size() == n;
+}
+
+// Slack basis: [A | I | b] with the objective row -c
+Tableau initialTableau(const Problem &problem, Workspace &workspace) {
+    const std::size_t m = problem.numConstraints;
+    const std::size_t n = problem.numVariables;
+    const std::size_t width = n + m + 1; // variables + slacks + RHS
+    const std::size_t height = m + 1;    // constraints + objective
+
+    Tableau tableau(height, width, workspace.tableau);
+    std::vector<std::size_t> &basis = workspace.basis;
+    basis.assign(m, 0);
+
+    // Populate constraints
+    for (std::size_t i = 0; i < m; ++i) {
+        const double *rowCoeffs = problem.A.data() + i * n;
+        std::copy(rowCoeffs, rowCoeffs + n, tableau.rowPtr(i));
+        tableau(i, n + i) = 1.0;
+        tableau(i, width - 1) = problem.b[i];
+        basis[i] = n + i;
+    }
+
+    // Objective row (maximization)
+    const std::size_t objectiveRow = m;
+    for (std::size_t j = 0; j < n; ++j) {
+        tableau(objectiveRow, j) = -problem.c[j];
+    }
+    return tableau;
+}
+
+Solution extractSolution(const Tableau &tableau, const std::vector<std::size_t> &basis, std::size_t n) {
+    const std::size_t m = basis.size();
+    const std::size_t width = tableau.width();
+    Solution solution;
+    solution.status = Status::Optimal;
+    solution.variables.assign(n, 0.0);
+    for (std::size_t i = 0; i < m; ++i) {
+        const std::size_t basicVar = basis[i];
+        if (basicVar < n) {
+            solution.variables[basicVar] = tableau(i, width - 1);
+        }
+    }
+    solution.objective = tableau(m, width - 1);
+    return solution;
+}
+
 } // namespace
 
 std::string statusToString(Status status) {
@@ -46,6 +186,12 @@ std::string statusToString(Status status) {
             return "unbounded";
         case Status::Infeasible:
             return "infeasible";
+        case Status::IterationLimit:
+            return "iteration_limit";
+        case Status::InfeasibleStart:
+            return "infeasible_start";
+        case Status::Cancelled:
+            return "cancelled";
         case Status::InvalidInput:
         default:
             return "invalid_input";
@@ -53,16 +199,15 @@ std::string statusToString(Status status) {
 }
 
 Solution SimplexSolver::solve(const Problem &problem) const {
+    Workspace workspace;
+    return solve(problem, workspace);
+}
+
+Solution SimplexSolver::solve(const Problem &problem, Workspace &workspace) const {
     Solution solution;
     solution.status = Status::InvalidInput;
 
-    const std::size_t m = problem.numConstraints;
-    const std::size_t n = problem.numVariables;
-
-    if (m == 0 || n == 0) {
-        return solution;
-    }
-    if (problem.A.size() != m * n || problem.b.size() != m || problem.c.size() != n) {
+    if (!validShape(problem)) {
         return solution;
     }
 
@@ -73,104 +218,110 @@ Solution SimplexSolver::solve(const Problem &problem) const {
         }
     }
 
-    const std::size_t width = n + m + 1; // variables + slacks + RHS
-    const std::size_t height = m + 1;    // constraints + objective
+    Tableau tableau = initialTableau(problem, workspace);
+    const Status status = iterate(tableau, workspace.basis, options_);
+    if (status != Status::Optimal) {
+        solution.status = status;
+        return solution;
+    }
+    return extractSolution(tableau, workspace.basis, problem.numVariables);
+}
 
-    Tableau tableau(height, width);
-    std::vector<std::size_t> basis(m, 0);
+Solution SimplexSolver::solveFrom(const Problem &problem,
+                                  const std::vector<double> &point,
+                                  Workspace &workspace) const {
+    Solution solution;
+    solution.status = Status::InvalidInput;
 
-    // Populate constraints
-    for (std::size_t i = 0; i < m; ++i) {
-        const double *rowCoeffs = problem.A.data() + i * n;
-        std::copy(rowCoeffs, rowCoeffs + n, tableau.rowPtr(i));
-        tableau(i, n + i) = 1.0;
-        tableau(i, width - 1) = problem.b[i];
-        basis[i] = n + i;
+    const std::size_t m = problem.numConstraints;
+    const std::size_t n = problem.numVariables;
+    if (!validShape(problem) || point.size() != n) {
+        return solution;
     }
 
-    // Objective row (maximization)
+    Tableau tableau = initialTableau(problem, workspace);
+    std::vector<std::size_t> &basis = workspace.basis;
+    const std::size_t width = tableau.width();
     const std::size_t objectiveRow = m;
-    for (std::size_t j = 0; j < n; ++j) {
-        tableau(objectiveRow, j) = -problem.c[j];
-    }
 
-    Status status = Status::Optimal;
-
-    while (true) {
-        double mostNegative = 0.0;
-        std::size_t pivotCol = width; // invalid sentinel
-        for (std::size_t j = 0; j < width - 1; ++j) {
-            const double coeff = tableau(objectiveRow, j);
-            if (coeff < mostNegative - kEps) {
-                mostNegative = coeff;
-                pivotCol = j;
-            }
+    // Start from the slack basis with the point's own values: the slacks
+    // are basic at s = b - A x and every positive x_j is "superbasic"
+    // (nonbasic but away from zero)
+    std::vector<double> basicValues(m);
+    double scale = 1.0;
+    for (std::size_t i = 0; i < m; ++i) {
+        const double *row = problem.A.data() + i * n;
+        double activity = 0.0;
+        for (std::size_t j = 0; j < n; ++j) {
+            activity += row[j] * std::max(point[j], 0.0);
         }
+        basicValues[i] = std::max(problem.b[i] - activity, 0.0);
+        scale = std::max(scale, std::fabs(problem.b[i]));
+    }
 
-        if (pivotCol == width) {
-            break; // optimal reached
+    // Primal push: move each superbasic to zero, or into the basis when a
+    // basic variable blocks first. The direction never lowers the
+    // objective (up when its reduced cost says entering pays), so the
+    // vertex reached is at least as good as the point.
+    for (std::size_t j = 0; j < n; ++j) {
+        const double value = point[j];
+        if (!(value > 0.0)) {
+            continue;
         }
-
-        double bestRatio = std::numeric_limits<double>::infinity();
-        std::size_t pivotRow = height; // invalid sentinel
+        const bool increase = tableau(objectiveRow, j) < -kEps;
+        double step = increase ? std::numeric_limits<double>::infinity() : value;
+        std::size_t blockingRow = m; // none
         for (std::size_t i = 0; i < m; ++i) {
-            const double coeff = tableau(i, pivotCol);
-            if (coeff > kEps) {
-                const double rhs = tableau(i, width - 1);
-                const double ratio = rhs / coeff;
-                if (ratio < bestRatio - kEps) {
-                    bestRatio = ratio;
-                    pivotRow = i;
+            const double coeff = tableau(i, j);
+            // Decreasing x_j moves basic i by +coeff per unit, increasing by -coeff
+            const double rate = increase ? -coeff : coeff;
+            if (rate < -kEps) {
+                const double ratio = basicValues[i] / -rate;
+                if (ratio < step) {
+                    step = ratio;
+                    blockingRow = i;
                 }
             }
         }
-
-        if (pivotRow == height) {
-            status = Status::Unbounded;
-            break;
+        if (blockingRow == m && increase) {
+            solution.status = Status::Unbounded;
+            return solution;
         }
 
-        const double pivot = tableau(pivotRow, pivotCol);
-        if (std::fabs(pivot) < kEps) {
-            status = Status::InvalidInput;
-            break;
+        const double move = increase ? -step : step;
+        for (std::size_t i = 0; i < m; ++i) {
+            basicValues[i] = std::max(basicValues[i] + move * tableau(i, j), 0.0);
         }
-
-        const double invPivot = 1.0 / pivot;
-        for (std::size_t j = 0; j < width; ++j) {
-            tableau(pivotRow, j) *= invPivot;
+        if (blockingRow != m) {
+            pivot(tableau, blockingRow, j);
+            basis[blockingRow] = j;
+            basicValues[blockingRow] = increase ? value + step : value - step;
         }
+    }
 
-        for (std::size_t i = 0; i < height; ++i) {
-            if (i == pivotRow) {
-                continue;
-            }
-            const double factor = tableau(i, pivotCol);
-            if (std::fabs(factor) <= kEps) {
-                continue;
-            }
-            for (std::size_t j = 0; j < width; ++j) {
-                tableau(i, j) -= factor * tableau(pivotRow, j);
+    // Every nonbasic is now zero, so the basic values are B^-1 b. Small
+    // negatives are rounding from an approximately feasible point; larger
+    // ones mean the point was infeasible. A cold start is only exact when
+    // the slack basis is feasible, i.e. b >= 0.
+    for (std::size_t i = 0; i < m; ++i) {
+        double &rhs = tableau(i, width - 1);
+        if (rhs < -1e-7 * scale) {
+            if (std::all_of(problem.b.begin(), problem.b.end(), [](double v) { return v >= 0.0; })) {
+                return solve(problem, workspace);
             }
+            solution.status = Status::InfeasibleStart;
+            return solution;
         }
-
-        basis[pivotRow] = pivotCol;
+        rhs = std::max(rhs, 0.0);
     }
 
-    solution.status = status;
+    // Finish with ordinary pivots from that vertex
+    const Status status = iterate(tableau, basis, options_);
     if (status != Status::Optimal) {
+        solution.status = status;
         return solution;
     }
-
-    solution.variables.assign(n, 0.0);
-    for (std::size_t i = 0; i < m; ++i) {
-        const std::size_t basicVar = basis[i];
-        if (basicVar < n) {
-            solution.variables[basicVar] = tableau(i, width - 1);
-        }
-    }
-    solution.objective = tableau(objectiveRow, width - 1);
-    return solution;
+    return extractSolution(tableau, basis, n);
 }
 
 } // namespace simplex
@@ -0,0 +1,109 @@
+#pragma once
+
+#include "gd/gradient_descent.hpp"
+#include "simplex/simplex.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace service {
+
+// ------------------------- Wire Protocol -------------------------
+// Every message is a frame: a u32 payload length followed by the payload.
+// Integers and doubles use the host's native (little-endian) layout, since
+// both ends live on the same machine. Requests carry a client-chosen id that
+// the matching response echoes; responses on a connection may arrive out of
+// order because jobs are solved in parallel.
+//
+// Request payload:  u8 kind, u8[7] reserved, u64 id, then
+//   LinearProgram:  u32 m, u32 n, f64 c[n], f64 A[m*n] (row-major), f64 b[m]
+//                   (maximize c^T x s.t. A x <= b, x >= 0; see simplex::Problem)
+//   Quadratic:      u32 n, u32 flags (bit 0: FISTA), f64 learningRate,
+//                   f64 tolerance, u64 maxIterations, u32 proximal, u32 reserved,
+//                   f64 proximalA, f64 proximalB, f64 Q[n*n], f64 q[n], f64 x0[n]
+//                   (minimize 0.5 x^T Q x + q^T x, optionally with a proximal term)
+// Response payload: u8 kind, u8 ok, u8 status, u8[5] reserved, u64 id, then
+//   ok:             f64 value, f64 gradNorm, u64 iterations, u32 n, u32 reserved, f64 x[n]
+//                   (status = simplex::Status or gd::StopReason)
+//   error:          u32 length, message bytes
+
+constexpr std::size_t kMaxFrameBytes = std::size_t{1} << 28;
+
+enum class JobKind : std::uint8_t {
+    LinearProgram = 1,
+    Quadratic = 2
+};
+
+// Proximal term of a quadratic job (see gd/proximal.hpp); A/B are the
+// operator's parameters (box lower/upper, simplex or ball radius, L1 weight)
+enum class ProximalKind : std::uint32_t {
+    None = 0,
+    Box = 1,
+    Simplex = 2,
+    L1 = 3,
+    L2Ball = 4
+};
+
+struct QuadraticJob {
+    std::size_t dimension = 0;
+    std::vector<double> hessian;   // Q, row-major n x n
+    std::vector<double> linear;    // q
+    std::vector<double> start;     // x0
+    gd::OptimConfig config;
+    ProximalKind proximal = ProximalKind::None;
+    double proximalA = 0.0;
+    double proximalB = 0.0;
+    bool accelerate = false;
+};
+
+struct Request {
+    JobKind kind = JobKind::LinearProgram;
+    std::uint64_t id = 0;
+    simplex::Problem linearProgram;
+    QuadraticJob quadratic;
+};
+
+struct Response {
+    JobKind kind = JobKind::LinearProgram;
+    std::uint64_t id = 0;
+    bool ok = false;
+    std::uint8_t status = 0;
+    double value = 0.0;
+    double gradNorm = 0.0;
+    std::uint64_t iterations = 0;
+    std::vector<double> x;
+    std::string error;
+};
+
+// Append one complete frame (length prefix included) to `out`
+void encodeRequest(const Request& request, std::vector<unsigned char>& out);
+void encodeResponse(const Response& response, std::vector<unsigned char>& out);
+
+// Decode a frame payload; throw std::runtime_error on malformed input
+Request decodeRequest(const unsigned char* data, std::size_t size);
+Response decodeResponse(const unsigned char* data, std::size_t size);
+
+// Buffered frame reader over a blocking socket
+class FrameReader {
+public:
+    explicit FrameReader(int fd, std::size_t bufferSize = 1 << 16);
+
+    // Reads the next payload; false on orderly EOF between frames. Throws on
+    // I/O errors, truncated frames and frames above kMaxFrameBytes.
+    bool next(std::vector<unsigned char>& payload);
+
+private:
+    bool fill(); // false on EOF
+
+    int fd_;
+    std::vector<unsigned char> buffer_;
+    std::size_t begin_ = 0;
+    std::size_t end_ = 0;
+};
+
+// Writes all bytes, retrying on short writes and EINTR; throws on errors
+void writeAll(int fd, const unsigned char* data, std::size_t size);
+
+} // namespace service
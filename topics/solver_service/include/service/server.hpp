@@ -0,0 +1,78 @@
+#pragma once
+
+#include "gd/thread_pool.hpp"
+#include "service/protocol.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace service {
+
+// ------------------------- Job Execution -------------------------
+// Solves one request on the calling thread. LP jobs reuse a per-thread
+// simplex::Workspace; quadratic jobs reuse a per-thread objective for each
+// dimension, so steady traffic of similar shapes does not allocate solver
+// scratch space. Failures are reported in the response, never thrown.
+struct ExecutionLimits {
+    std::size_t maxIterations = 0;              // caps GD iterations and simplex pivots; 0 = no cap
+    const std::atomic<bool>* cancel = nullptr;  // once set, jobs end as cancelled
+};
+
+Response execute(const Request& request, const ExecutionLimits& limits = {});
+
+// ------------------------- Server -------------------------
+struct ServerOptions {
+    std::string socketPath;
+    std::size_t threads = 0;        // solver threads; 0 -> hardware concurrency
+    std::size_t maxInFlight = 256;  // per connection; reading pauses beyond this
+    std::size_t maxIterations = 1000000; // per job (GD iterations, LP pivots); 0 = no cap
+};
+
+// Long-running solver daemon on a Unix domain socket. Each connection is a
+// three-stage pipeline: a reader thread decodes frames and submits jobs to
+// the shared, always-warm solver pool; solver threads encode the response
+// into the connection's outbox; a writer thread flushes whatever has
+// accumulated in one send. Clients may therefore keep many requests in
+// flight and match responses by id.
+class Server {
+public:
+    // Binds and listens; throws std::runtime_error. An existing socket file
+    // is replaced only if no server answers on it; a live server or a path
+    // that is not a socket is left alone and reported.
+    explicit Server(ServerOptions options);
+    ~Server();
+
+    Server(const Server&) = delete;
+    Server& operator=(const Server&) = delete;
+
+    // Accepts and serves connections until stop(); then drains in-flight jobs
+    // of open connections before returning
+    void run();
+
+    // Makes run() return; safe to call from any thread. Running and queued
+    // jobs are cancelled so the drain does not wait for them to converge.
+    void stop();
+
+private:
+    class Connection;
+
+    void reapFinished();
+
+    ServerOptions options_;
+    int listenFd_ = -1;
+    bool ownsSocket_ = false;          // this instance bound the socket file
+    std::uint64_t socketDevice_ = 0;   // identity of that file, so the
+    std::uint64_t socketInode_ = 0;    // destructor never unlinks a successor
+    std::atomic<bool> stopping_{false};
+    ExecutionLimits limits_;
+    gd::ThreadPool pool_;
+    std::mutex connectionsMutex_;
+    std::vector<std::shared_ptr<Connection>> connections_;
+};
+
+} // namespace service
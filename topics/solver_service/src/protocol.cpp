@@ -0,0 +1,291 @@
+#include "service/protocol.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace service {
+namespace {
+
+template <class T>
+void put(std::vector<unsigned char>& out, const T& value) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&value);
+    out.insert(out.end(), bytes, bytes + sizeof(T));
+}
+
+void putDoubles(std::vector<unsigned char>& out, const std::vector<double>& values) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(values.data());
+    out.insert(out.end(), bytes, bytes + values.size() * sizeof(double));
+}
+
+void putHeader(std::vector<unsigned char>& out, JobKind kind, std::uint8_t b1, std::uint8_t b2, std::uint64_t id) {
+    put<std::uint8_t>(out, static_cast<std::uint8_t>(kind));
+    put<std::uint8_t>(out, b1);
+    put<std::uint8_t>(out, b2);
+    const unsigned char reserved[5] = {};
+    out.insert(out.end(), reserved, reserved + sizeof(reserved));
+    put<std::uint64_t>(out, id);
+}
+
+// Reserves the length prefix; finishFrame() fills it in
+std::size_t beginFrame(std::vector<unsigned char>& out) {
+    const std::size_t start = out.size();
+    put<std::uint32_t>(out, 0);
+    return start;
+}
+
+void finishFrame(std::vector<unsigned char>& out, std::size_t start) {
+    const std::size_t payload = out.size() - start - sizeof(std::uint32_t);
+    if (payload > kMaxFrameBytes) {
+        throw std::runtime_error("Message exceeds the maximum frame size");
+    }
+    const auto length = static_cast<std::uint32_t>(payload);
+    std::memcpy(out.data() + start, &length, sizeof(length));
+}
+
+class Cursor {
+public:
+    Cursor(const unsigned char* data, std::size_t size)
+        : data_(data), size_(size) {}
+
+    template <class T>
+    T get() {
+        T value{};
+        take(&value, sizeof(T));
+        return value;
+    }
+
+    void getDoubles(std::vector<double>& out, std::size_t count) {
+        if (count > (size_ - offset_) / sizeof(double)) {
+            truncated();
+        }
+        out.resize(count);
+        take(out.data(), count * sizeof(double));
+    }
+
+    void skip(std::size_t bytes) {
+        if (bytes > size_ - offset_) {
+            truncated();
+        }
+        offset_ += bytes;
+    }
+
+    void expectEnd() const {
+        if (offset_ != size_) {
+            throw std::runtime_error("Trailing bytes in message");
+        }
+    }
+
+private:
+    [[noreturn]] static void truncated() {
+        throw std::runtime_error("Truncated message");
+    }
+
+    void take(void* out, std::size_t size) {
+        if (size > size_ - offset_) {
+            truncated();
+        }
+        std::memcpy(out, data_ + offset_, size);
+        offset_ += size;
+    }
+
+    const unsigned char* data_;
+    std::size_t size_;
+    std::size_t offset_ = 0;
+};
+
+JobKind toJobKind(std::uint8_t raw) {
+    if (raw != static_cast<std::uint8_t>(JobKind::LinearProgram) &&
+        raw != static_cast<std::uint8_t>(JobKind::Quadratic)) {
+        throw std::runtime_error("Unknown job kind " + std::to_string(raw));
+    }
+    return static_cast<JobKind>(raw);
+}
+
+} // namespace
+
+// ------------------------- Encoding -------------------------
+void encodeRequest(const Request& request, std::vector<unsigned char>& out) {
+    const std::size_t frame = beginFrame(out);
+    putHeader(out, request.kind, 0, 0, request.id);
+    if (request.kind == JobKind::LinearProgram) {
+        const simplex::Problem& lp = request.linearProgram;
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(lp.numConstraints));
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(lp.numVariables));
+        putDoubles(out, lp.c);
+        putDoubles(out, lp.A);
+        putDoubles(out, lp.b);
+    } else {
+        const QuadraticJob& job = request.quadratic;
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(job.dimension));
+        put<std::uint32_t>(out, job.accelerate ? 1u : 0u);
+        put<double>(out, job.config.learningRate);
+        put<double>(out, job.config.tolerance);
+        put<std::uint64_t>(out, job.config.maxIterations);
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(job.proximal));
+        put<std::uint32_t>(out, 0);
+        put<double>(out, job.proximalA);
+        put<double>(out, job.proximalB);
+        putDoubles(out, job.hessian);
+        putDoubles(out, job.linear);
+        putDoubles(out, job.start);
+    }
+    finishFrame(out, frame);
+}
+
+void encodeResponse(const Response& response, std::vector<unsigned char>& out) {
+    const std::size_t frame = beginFrame(out);
+    putHeader(out, response.kind, response.ok ? 1 : 0, response.status, response.id);
+    if (response.ok) {
+        put<double>(out, response.value);
+        put<double>(out, response.gradNorm);
+        put<std::uint64_t>(out, response.iterations);
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(response.x.size()));
+        put<std::uint32_t>(out, 0);
+        putDoubles(out, response.x);
+    } else {
+        put<std::uint32_t>(out, static_cast<std::uint32_t>(response.error.size()));
+        out.insert(out.end(), response.error.begin(), response.error.end());
+    }
+    finishFrame(out, frame);
+}
+
+// ------------------------- Decoding -------------------------
+Request decodeRequest(const unsigned char* data, std::size_t size) {
+    Cursor in(data, size);
+    Request request;
+    request.kind = toJobKind(in.get<std::uint8_t>());
+    in.skip(7);
+    request.id = in.get<std::uint64_t>();
+
+    if (request.kind == JobKind::LinearProgram) {
+        simplex::Problem& lp = request.linearProgram;
+        lp.numConstraints = in.get<std::uint32_t>();
+        lp.numVariables = in.get<std::uint32_t>();
+        in.getDoubles(lp.c, lp.numVariables);
+        in.getDoubles(lp.A, lp.numConstraints * lp.numVariables);
+        in.getDoubles(lp.b, lp.numConstraints);
+    } else {
+        QuadraticJob& job = request.quadratic;
+        job.dimension = in.get<std::uint32_t>();
+        job.accelerate = (in.get<std::uint32_t>() & 1u) != 0;
+        job.config.learningRate = in.get<double>();
+        job.config.tolerance = in.get<double>();
+        job.config.maxIterations = static_cast<std::size_t>(in.get<std::uint64_t>());
+        const auto proximal = in.get<std::uint32_t>();
+        if (proximal > static_cast<std::uint32_t>(ProximalKind::L2Ball)) {
+            throw std::runtime_error("Unknown proximal kind " + std::to_string(proximal));
+        }
+        job.proximal = static_cast<ProximalKind>(proximal);
+        in.skip(4);
+        job.proximalA = in.get<double>();
+        job.proximalB = in.get<double>();
+        in.getDoubles(job.hessian, job.dimension * job.dimension);
+        in.getDoubles(job.linear, job.dimension);
+        in.getDoubles(job.start, job.dimension);
+    }
+    in.expectEnd();
+    return request;
+}
+
+Response decodeResponse(const unsigned char* data, std::size_t size) {
+    Cursor in(data, size);
+    Response response;
+    response.kind = toJobKind(in.get<std::uint8_t>());
+    response.ok = in.get<std::uint8_t>() != 0;
+    response.status = in.get<std::uint8_t>();
+    in.skip(5);
+    response.id = in.get<std::uint64_t>();
+    if (response.ok) {
+        response.value = in.get<double>();
+        response.gradNorm = in.get<double>();
+        response.iterations = in.get<std::uint64_t>();
+        const auto count = in.get<std::uint32_t>();
+        in.skip(4);
+        in.getDoubles(response.x, count);
+    } else {
+        const auto length = in.get<std::uint32_t>();
+        response.error.resize(length);
+        for (char& ch : response.error) {
+            ch = static_cast<char>(in.get<std::uint8_t>());
+        }
+    }
+    in.expectEnd();
+    return response;
+}
+
+// ------------------------- Socket I/O -------------------------
+FrameReader::FrameReader(int fd, std::size_t bufferSize)
+    : fd_(fd), buffer_(bufferSize < 64 ? 64 : bufferSize) {}
+
+bool FrameReader::fill() {
+    if (begin_ == end_) {
+        begin_ = end_ = 0;
+    } else if (end_ == buffer_.size()) {
+        std::memmove(buffer_.data(), buffer_.data() + begin_, end_ - begin_);
+        end_ -= begin_;
+        begin_ = 0;
+    }
+    while (true) {
+        const ssize_t got = ::read(fd_, buffer_.data() + end_, buffer_.size() - end_);
+        if (got > 0) {
+            end_ += static_cast<std::size_t>(got);
+            return true;
+        }
+        if (got == 0) {
+            return false;
+        }
+        if (errno != EINTR) {
+            throw std::runtime_error(std::string("Socket read failed: ") + std::strerror(errno));
+        }
+    }
+}
+
+bool FrameReader::next(std::vector<unsigned char>& payload) {
+    while (end_ - begin_ < sizeof(std::uint32_t)) {
+        const bool atBoundary = (begin_ == end_);
+        if (!fill()) {
+            if (atBoundary) return false;
+            throw std::runtime_error("Connection closed inside a frame");
+        }
+    }
+    std::uint32_t length = 0;
+    std::memcpy(&length, buffer_.data() + begin_, sizeof(length));
+    if (length > kMaxFrameBytes) {
+        throw std::runtime_error("Frame exceeds the maximum size");
+    }
+    begin_ += sizeof(length);
+
+    payload.resize(length);
+    std::size_t copied = 0;
+    while (copied < length) {
+        if (begin_ == end_ && !fill()) {
+            throw std::runtime_error("Connection closed inside a frame");
+        }
+        const std::size_t chunk = std::min<std::size_t>(length - copied, end_ - begin_);
+        std::memcpy(payload.data() + copied, buffer_.data() + begin_, chunk);
+        begin_ += chunk;
+        copied += chunk;
+    }
+    return true;
+}
+
+void writeAll(int fd, const unsigned char* data, std::size_t size) {
+    while (size > 0) {
+        // MSG_NOSIGNAL: a vanished peer is an error, not a SIGPIPE
+        const ssize_t sent = ::send(fd, data, size, MSG_NOSIGNAL);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("Socket write failed: ") + std::strerror(errno));
+        }
+        data += sent;
+        size -= static_cast<std::size_t>(sent);
+    }
+}
+
+} // namespace service
@@ -0,0 +1,410 @@
+#include "service/server.hpp"
+
+#include "gd/proximal.hpp"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+namespace service {
+namespace {
+
+// 0.5 x^T Q x + q^T x with Q and q reloaded for every job
+class QuadraticObjective final : public gd::Objective {
+public:
+    explicit QuadraticObjective(std::size_t dimension)
+        : Objective(dimension) {}
+
+    void load(const QuadraticJob& job) {
+        hessian_.assign(job.hessian.begin(), job.hessian.end());
+        linear_.assign(job.linear.begin(), job.linear.end());
+    }
+
+    double value(const gd::Vector& x) const override {
+        ensureDimension(x);
+        const std::size_t n = x.size();
+        double result = 0.0;
+        for (std::size_t i = 0; i < n; ++i) {
+            const double* row = hessian_.data() + i * n;
+            double qx = 0.0;
+            for (std::size_t j = 0; j < n; ++j) {
+                qx += row[j] * x[j];
+            }
+            result += x[i] * (0.5 * qx + linear_[i]);
+        }
+        return result;
+    }
+
+    bool hasAnalyticGradient() const noexcept override { return true; }
+
+    gd::Vector analyticGradient(const gd::Vector& x) const override {
+        ensureDimension(x);
+        const std::size_t n = x.size();
+        gd::Vector grad(linear_);
+        for (std::size_t i = 0; i < n; ++i) {
+            const double* row = hessian_.data() + i * n;
+            double qx = 0.0;
+            for (std::size_t j = 0; j < n; ++j) {
+                qx += row[j] * x[j];
+            }
+            grad[i] += qx;
+        }
+        return grad;
+    }
+
+private:
+    gd::Vector hessian_;
+    gd::Vector linear_;
+};
+
+// Per-thread objective for each dimension seen recently
+QuadraticObjective& quadraticFor(const QuadraticJob& job) {
+    constexpr std::size_t kMaxCachedShapes = 64;
+    thread_local std::unordered_map<std::size_t, std::unique_ptr<QuadraticObjective>> cache;
+    auto it = cache.find(job.dimension);
+    if (it == cache.end()) {
+        if (cache.size() >= kMaxCachedShapes) {
+            cache.clear();
+        }
+        it = cache.emplace(job.dimension, std::make_unique<QuadraticObjective>(job.dimension)).first;
+    }
+    it->second->load(job);
+    return *it->second;
+}
+
+std::shared_ptr<const gd::ProximalOperator> makeProximal(const QuadraticJob& job) {
+    switch (job.proximal) {
+        case ProximalKind::Box:
+            return std::make_shared<gd::BoxProjection>(job.proximalA, job.proximalB);
+        case ProximalKind::Simplex:
+            return std::make_shared<gd::SimplexProjection>(job.proximalA);
+        case ProximalKind::L1:
+            return std::make_shared<gd::L1Proximal>(job.proximalA);
+        case ProximalKind::L2Ball:
+            return std::make_shared<gd::L2BallProjection>(job.proximalA);
+        case ProximalKind::None:
+        default:
+            return nullptr;
+    }
+}
+
+// Ends a GD job once the server is shutting down
+class CancelWatch final : public gd::Callback {
+public:
+    explicit CancelWatch(const std::atomic<bool>& cancel) : cancel_(cancel) {}
+
+    void onIteration(gd::TrainerState& state) override {
+        if (cancel_.load(std::memory_order_relaxed)) {
+            state.requestStop(gd::StopReason::Cancelled);
+        }
+    }
+
+private:
+    const std::atomic<bool>& cancel_;
+};
+
+void closeQuietly(int fd) {
+    if (fd >= 0) {
+        ::close(fd);
+    }
+}
+
+// Removes a socket file left behind by a server that is gone. Refuses to
+// touch anything that is not a socket or that still accepts connections.
+void removeStaleSocket(const std::string& path, const sockaddr_un& address) {
+    struct stat info {};
+    if (::lstat(path.c_str(), &info) != 0) {
+        if (errno == ENOENT) return;
+        throw std::runtime_error("Cannot stat " + path + ": " + std::strerror(errno));
+    }
+    if (!S_ISSOCK(info.st_mode)) {
+        throw std::runtime_error(path + " exists and is not a socket");
+    }
+
+    const int probe = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (probe < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+    const int connected = ::connect(probe, reinterpret_cast<const sockaddr*>(&address), sizeof(address));
+    const int error = errno;
+    closeQuietly(probe);
+    if (connected == 0) {
+        throw std::runtime_error("A server is already running on " + path);
+    }
+    if (error != ECONNREFUSED) {
+        throw std::runtime_error("Cannot probe " + path + ": " + std::strerror(error));
+    }
+    if (::unlink(path.c_str()) != 0 && errno != ENOENT) {
+        throw std::runtime_error("Cannot remove stale socket " + path + ": " + std::strerror(errno));
+    }
+}
+
+} // namespace
+
+// ------------------------- Job Execution -------------------------
+Response execute(const Request& request, const ExecutionLimits& limits) {
+    Response response;
+    response.kind = request.kind;
+    response.id = request.id;
+    try {
+        if (request.kind == JobKind::LinearProgram) {
+            thread_local simplex::Workspace workspace;
+            simplex::SimplexOptions options;
+            options.maxPivots = limits.maxIterations;
+            options.cancel = limits.cancel;
+            const simplex::SimplexSolver solver(options);
+            simplex::Solution solution = solver.solve(request.linearProgram, workspace);
+            response.status = static_cast<std::uint8_t>(solution.status);
+            response.value = solution.objective;
+            response.x = std::move(solution.variables);
+        } else {
+            const QuadraticJob& job = request.quadratic;
+            QuadraticObjective& objective = quadraticFor(job);
+            const gd::Trainer trainer(makeProximal(job), job.accelerate);
+            gd::OptimConfig config = job.config;
+            if (limits.maxIterations != 0 && config.maxIterations > limits.maxIterations) {
+                config.maxIterations = limits.maxIterations;
+            }
+            std::vector<std::shared_ptr<gd::Callback>> callbacks;
+            if (limits.cancel != nullptr) {
+                callbacks.push_back(std::make_shared<CancelWatch>(*limits.cancel));
+            }
+            response.x = job.start;
+            const gd::TrainStats stats = trainer.minimize(objective, response.x, config, callbacks);
+            response.status = static_cast<std::uint8_t>(stats.stopReason);
+            response.value = stats.finalValue;
+            response.gradNorm = stats.finalGradNorm;
+            response.iterations = stats.iterations;
+        }
+        response.ok = true;
+    } catch (const std::exception& ex) {
+        response.ok = false;
+        response.x.clear();
+        response.error = ex.what();
+    }
+    return response;
+}
+
+// ------------------------- Connection -------------------------
+class Server::Connection : public std::enable_shared_from_this<Connection> {
+public:
+    Connection(int fd, gd::ThreadPool& pool, const ExecutionLimits& limits, std::size_t maxInFlight)
+        : fd_(fd), pool_(pool), limits_(limits), maxInFlight_(maxInFlight == 0 ? 1 : maxInFlight) {}
+
+    ~Connection() { closeQuietly(fd_); }
+
+    void start() {
+        auto self = shared_from_this();
+        writer_ = std::thread([self] { self->writeLoop(); });
+        reader_ = std::thread([self] { self->readLoop(); });
+    }
+
+    // Ends the read side so the reader stops after the current frame
+    void shutdownRead() { ::shutdown(fd_, SHUT_RD); }
+
+    void join() {
+        if (reader_.joinable()) reader_.join();
+        if (writer_.joinable()) writer_.join();
+    }
+
+    bool finished() const noexcept { return finished_.load(std::memory_order_acquire); }
+
+private:
+    void readLoop() {
+        FrameReader reader(fd_);
+        std::vector<unsigned char> payload;
+        try {
+            while (reader.next(payload)) {
+                auto request = std::make_shared<Request>(decodeRequest(payload.data(), payload.size()));
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    slotFree_.wait(lock, [this] { return inFlight_ < maxInFlight_; });
+                    ++inFlight_;
+                }
+                auto self = shared_from_this();
+                pool_.submit([self, request] { self->complete(execute(*request, self->limits_)); });
+            }
+        } catch (const std::exception& ex) {
+            // Malformed stream: report once and stop reading from this client
+            Response response;
+            response.error = ex.what();
+            std::vector<unsigned char> frame;
+            encodeResponse(response, frame);
+            std::lock_guard<std::mutex> lock(mutex_);
+            outbox_.insert(outbox_.end(), frame.begin(), frame.end());
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            readerDone_ = true;
+        }
+        outboxReady_.notify_one();
+    }
+
+    // Runs on a solver thread
+    void complete(const Response& response) {
+        std::vector<unsigned char> frame;
+        encodeResponse(response, frame);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outbox_.insert(outbox_.end(), frame.begin(), frame.end());
+            --inFlight_;
+        }
+        outboxReady_.notify_one();
+        slotFree_.notify_one();
+    }
+
+    void writeLoop() {
+        std::vector<unsigned char> batch;
+        bool broken = false;
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            outboxReady_.wait(lock, [this] { return !outbox_.empty() || (readerDone_ && inFlight_ == 0); });
+            if (outbox_.empty()) break;
+            batch.clear();
+            batch.swap(outbox_);
+            lock.unlock();
+            if (!broken) {
+                try {
+                    writeAll(fd_, batch.data(), batch.size());
+                } catch (const std::exception&) {
+                    // Peer went away: keep draining results, stop reading
+                    broken = true;
+                    shutdownRead();
+                }
+            }
+            lock.lock();
+        }
+        lock.unlock();
+        ::shutdown(fd_, SHUT_WR);
+        finished_.store(true, std::memory_order_release);
+    }
+
+    int fd_;
+    gd::ThreadPool& pool_;
+    const ExecutionLimits& limits_;   // owned by the Server, which outlives us
+    std::size_t maxInFlight_;
+
+    std::mutex mutex_;
+    std::condition_variable outboxReady_;
+    std::condition_variable slotFree_;
+    std::vector<unsigned char> outbox_; // encoded frames not yet written
+    std::size_t inFlight_ = 0;
+    bool readerDone_ = false;
+    std::atomic<bool> finished_{false};
+
+    std::thread reader_;
+    std::thread writer_;
+};
+
+// ------------------------- Server -------------------------
+Server::Server(ServerOptions options)
+    : options_(std::move(options)), limits_{options_.maxIterations, &stopping_}, pool_(options_.threads) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (options_.socketPath.empty() || options_.socketPath.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Invalid socket path: " + options_.socketPath);
+    }
+    std::memcpy(address.sun_path, options_.socketPath.c_str(), options_.socketPath.size() + 1);
+
+    removeStaleSocket(options_.socketPath, address);
+
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0) {
+        throw std::runtime_error(std::string("socket() failed: ") + std::strerror(errno));
+    }
+    if (::bind(listenFd_, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0) {
+        const std::string error = std::strerror(errno);
+        closeQuietly(listenFd_);
+        throw std::runtime_error("Failed to bind " + options_.socketPath + ": " + error);
+    }
+    ownsSocket_ = true;
+    struct stat info {};
+    if (::lstat(options_.socketPath.c_str(), &info) == 0) {
+        socketDevice_ = static_cast<std::uint64_t>(info.st_dev);
+        socketInode_ = static_cast<std::uint64_t>(info.st_ino);
+    }
+    if (::listen(listenFd_, 128) != 0) {
+        const std::string error = std::strerror(errno);
+        closeQuietly(listenFd_);
+        ::unlink(options_.socketPath.c_str());
+        throw std::runtime_error("Failed to listen on " + options_.socketPath + ": " + error);
+    }
+}
+
+Server::~Server() {
+    stop();
+    closeQuietly(listenFd_);
+    // Only remove the file this instance bound, and only if nobody has
+    // replaced it since
+    struct stat info {};
+    if (ownsSocket_ && ::lstat(options_.socketPath.c_str(), &info) == 0 && S_ISSOCK(info.st_mode) &&
+        static_cast<std::uint64_t>(info.st_dev) == socketDevice_ &&
+        static_cast<std::uint64_t>(info.st_ino) == socketInode_) {
+        ::unlink(options_.socketPath.c_str());
+    }
+}
+
+void Server::run() {
+    while (!stopping_.load(std::memory_order_acquire)) {
+        const int fd = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            if (stopping_.load(std::memory_order_acquire)) break;
+            throw std::runtime_error(std::string("accept() failed: ") + std::strerror(errno));
+        }
+        reapFinished();
+        auto connection = std::make_shared<Connection>(fd, pool_, limits_, options_.maxInFlight);
+        connection->start();
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        connections_.push_back(std::move(connection));
+    }
+
+    std::vector<std::shared_ptr<Connection>> open;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        open.swap(connections_);
+    }
+    for (auto& connection : open) {
+        connection->shutdownRead();
+    }
+    for (auto& connection : open) {
+        connection->join();
+    }
+}
+
+void Server::stop() {
+    if (stopping_.exchange(true)) return;
+    // Wakes a blocked accept()
+    ::shutdown(listenFd_, SHUT_RDWR);
+}
+
+void Server::reapFinished() {
+    std::vector<std::shared_ptr<Connection>> done;
+    {
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        auto it = connections_.begin();
+        while (it != connections_.end()) {
+            if ((*it)->finished()) {
+                done.push_back(std::move(*it));
+                it = connections_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto& connection : done) {
+        connection->join();
+    }
+}
+
+} // namespace service
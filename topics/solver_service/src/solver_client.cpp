@@ -0,0 +1,239 @@
+#include "service/protocol.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Args {
+    std::string socketPath;
+    std::string lpPath;
+    std::vector<double> quadratic;   // a11, a22, a12, b1, b2
+    std::vector<double> start{0.0, 0.0};
+    double alpha{0.1};
+    double eps{1e-3};
+    std::size_t maxIters{200};
+    bool box{false};
+    double boxLower{0.0};
+    double boxUpper{0.0};
+    bool fista{false};
+    std::size_t repeat{1};
+    std::size_t depth{1};
+};
+
+void usage(const char *prog) {
+    std::cerr << "Usage: " << prog << " --socket <path>"
+              << " (--lp <path> | --quadratic <a11>,<a22>,<a12>,<b1>,<b2> [--start <x1>,<x2>]"
+              << " [--alpha <v>] [--eps <v>] [--max-iters <n>] [--box <lo>:<hi>] [--fista])"
+              << " [--repeat <n>] [--depth <d>]\n";
+}
+
+// Comma-separated doubles; an empty result marks malformed input
+std::vector<double> parseList(const char *text) {
+    std::vector<double> values;
+    const char *cursor = text;
+    while (*cursor != '\0') {
+        char *end = nullptr;
+        values.push_back(std::strtod(cursor, &end));
+        if (end == cursor) {
+            return {};
+        }
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+    return values;
+}
+
+bool parseArgs(int argc, char **argv, Args &args) {
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--socket" && i + 1 < argc) {
+            args.socketPath = argv[++i];
+        } else if (arg == "--lp" && i + 1 < argc) {
+            args.lpPath = argv[++i];
+        } else if (arg == "--quadratic" && i + 1 < argc) {
+            args.quadratic = parseList(argv[++i]);
+        } else if (arg == "--start" && i + 1 < argc) {
+            args.start = parseList(argv[++i]);
+        } else if (arg == "--alpha" && i + 1 < argc) {
+            args.alpha = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--eps" && i + 1 < argc) {
+            args.eps = std::strtod(argv[++i], nullptr);
+        } else if (arg == "--max-iters" && i + 1 < argc) {
+            args.maxIters = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--box" && i + 1 < argc) {
+            char *end = nullptr;
+            args.box = true;
+            args.boxLower = std::strtod(argv[++i], &end);
+            if (*end != ':') return false;
+            args.boxUpper = std::strtod(end + 1, nullptr);
+        } else if (arg == "--fista") {
+            args.fista = true;
+        } else if (arg == "--repeat" && i + 1 < argc) {
+            args.repeat = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--depth" && i + 1 < argc) {
+            args.depth = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            return false;
+        }
+    }
+    const bool oneJob = args.lpPath.empty() != args.quadratic.empty();
+    const bool validQuadratic = args.quadratic.empty() || (args.quadratic.size() == 5 && args.start.size() == 2);
+    return !args.socketPath.empty() && oneJob && validQuadratic;
+}
+
+service::Request buildRequest(const Args &args) {
+    service::Request request;
+    if (!args.lpPath.empty()) {
+        std::ifstream file(args.lpPath);
+        if (!file.is_open()) {
+            throw std::runtime_error("Failed to open input file: " + args.lpPath);
+        }
+        request.kind = service::JobKind::LinearProgram;
+        request.linearProgram = simplex::readProblem(file);
+        return request;
+    }
+
+    // Same surface as gd2d: a11 x1^2 + a22 x2^2 + a12 x1 x2 + b1 x1 + b2 x2
+    const std::vector<double> &q = args.quadratic;
+    request.kind = service::JobKind::Quadratic;
+    service::QuadraticJob &job = request.quadratic;
+    job.dimension = 2;
+    job.hessian = {2.0 * q[0], q[2], q[2], 2.0 * q[1]};
+    job.linear = {q[3], q[4]};
+    job.start = args.start;
+    job.config.learningRate = args.alpha;
+    job.config.tolerance = args.eps;
+    job.config.maxIterations = args.maxIters;
+    if (args.box) {
+        job.proximal = service::ProximalKind::Box;
+        job.proximalA = args.boxLower;
+        job.proximalB = args.boxUpper;
+    }
+    job.accelerate = args.fista;
+    return request;
+}
+
+int connectTo(const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        throw std::runtime_error("Socket path too long: " + path);
+    }
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0 || ::connect(fd, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0) {
+        const std::string error = std::strerror(errno);
+        if (fd >= 0) ::close(fd);
+        throw std::runtime_error("Failed to connect to " + path + ": " + error);
+    }
+    return fd;
+}
+
+void printResponse(const service::Response &response) {
+    if (!response.ok) {
+        throw std::runtime_error("Server error: " + response.error);
+    }
+    if (response.kind == service::JobKind::LinearProgram) {
+        const auto status = static_cast<simplex::Status>(response.status);
+        if (status != simplex::Status::Optimal) {
+            std::cout << "Simplex failed: " << simplex::statusToString(status) << '\n';
+            return;
+        }
+        std::cout << "Optimal value: " << response.value << '\n';
+        for (std::size_t i = 0; i < response.x.size(); ++i) {
+            std::cout << "x" << (i + 1) << " = " << response.x[i] << '\n';
+        }
+        return;
+    }
+    std::cout << "Final value: " << response.value << " after " << response.iterations << " iterations ("
+              << gd::stopReasonToString(static_cast<gd::StopReason>(response.status)) << ")\n";
+    std::cout << "Minimizer x = (" << response.x[0] << ", " << response.x[1] << ")\n";
+}
+
+double percentile(const std::vector<double> &sorted, double q) {
+    if (sorted.empty()) return 0.0;
+    const std::size_t index = std::min(sorted.size() - 1, static_cast<std::size_t>(q * static_cast<double>(sorted.size())));
+    return sorted[index];
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Args args;
+    if (!parseArgs(argc, argv, args)) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+    args.repeat = std::max<std::size_t>(args.repeat, 1);
+    args.depth = std::max<std::size_t>(args.depth, 1);
+
+    int fd = -1;
+    try {
+        service::Request request = buildRequest(args);
+        fd = connectTo(args.socketPath);
+        service::FrameReader reader(fd);
+
+        // Keep up to `depth` requests in flight; ids index the send times
+        std::vector<Clock::time_point> sentAt(args.repeat);
+        std::vector<double> latencies;
+        latencies.reserve(args.repeat);
+        std::vector<unsigned char> outgoing;
+        std::vector<unsigned char> payload;
+        std::size_t sent = 0;
+        std::size_t received = 0;
+        const auto begin = Clock::now();
+
+        while (received < args.repeat) {
+            outgoing.clear();
+            while (sent < args.repeat && sent - received < args.depth) {
+                request.id = sent;
+                service::encodeRequest(request, outgoing);
+                sentAt[sent++] = Clock::now();
+            }
+            if (!outgoing.empty()) {
+                service::writeAll(fd, outgoing.data(), outgoing.size());
+            }
+            if (!reader.next(payload)) {
+                throw std::runtime_error("Server closed the connection");
+            }
+            const service::Response response = service::decodeResponse(payload.data(), payload.size());
+            if (!response.ok || received++ == 0) {
+                printResponse(response); // throws on errors
+            }
+            if (response.id >= args.repeat) {
+                throw std::runtime_error("Unexpected response id");
+            }
+            latencies.push_back(std::chrono::duration<double, std::micro>(Clock::now() - sentAt[response.id]).count());
+        }
+        const double seconds = std::chrono::duration<double>(Clock::now() - begin).count();
+
+        if (args.repeat > 1) {
+            std::sort(latencies.begin(), latencies.end());
+            std::cout << "requests: " << args.repeat << ", depth: " << args.depth
+                      << ", throughput: " << static_cast<double>(args.repeat) / seconds << " req/s\n";
+            std::cout << "latency us: p50 " << percentile(latencies, 0.5) << ", p99 " << percentile(latencies, 0.99)
+                      << ", max " << latencies.back() << '\n';
+        }
+        ::close(fd);
+    } catch (const std::exception &ex) {
+        if (fd >= 0) ::close(fd);
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
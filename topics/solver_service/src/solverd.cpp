@@ -0,0 +1,78 @@
+#include "service/server.hpp"
+
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <iostream>
+#include <pthread.h>
+#include <string>
+#include <thread>
+
+namespace {
+
+void usage(const char *prog) {
+    std::cerr << "Usage: " << prog << " --socket <path> [--threads <n>] [--max-in-flight <n>] [--max-iters <n>]\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    service::ServerOptions options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if ((arg == "--help") || (arg == "-h")) {
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        } else if (arg == "--socket" && i + 1 < argc) {
+            options.socketPath = argv[++i];
+        } else if (arg == "--threads" && i + 1 < argc) {
+            options.threads = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--max-in-flight" && i + 1 < argc) {
+            options.maxInFlight = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else if (arg == "--max-iters" && i + 1 < argc) {
+            options.maxIterations = static_cast<std::size_t>(std::strtoull(argv[++i], nullptr, 10));
+        } else {
+            std::cerr << "Unknown argument: " << arg << "\n";
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (options.socketPath.empty()) {
+        usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    // Block termination signals before any thread starts so every thread
+    // inherits the mask; a dedicated thread waits for them instead.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    try {
+        service::Server server(options);
+        std::thread signalWaiter([&server, signals] {
+            int received = 0;
+            sigwait(&signals, &received);
+            server.stop();
+        });
+        std::cerr << "solverd listening on " << options.socketPath << std::endl;
+        try {
+            server.run();
+        } catch (...) {
+            // Release the waiter before unwinding
+            pthread_kill(signalWaiter.native_handle(), SIGTERM);
+            signalWaiter.join();
+            throw;
+        }
+        // run() only returns after stop(), which only the waiter calls
+        signalWaiter.join();
+        std::cerr << "solverd stopped" << std::endl;
+    } catch (const std::exception &ex) {
+        std::cerr << "Error: " << ex.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}